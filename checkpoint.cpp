@@ -0,0 +1,238 @@
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+#include "checkpoint.h"
+
+namespace
+{
+  const char kMagic[4] = { 'H', 'P', 'C', 'K' };
+  const unsigned kVersion = 7;
+
+  template <typename T>
+  void Write(std::ostream& out, T const& value)
+  {
+    out.write(reinterpret_cast<char const*>(&value), sizeof(value));
+  }
+
+  template <typename T>
+  bool Read(std::istream& in, T& value)
+  {
+    return !!in.read(reinterpret_cast<char*>(&value), sizeof(value));
+  }
+
+  void AddTallies(PlayoffTallies& into, PlayoffTallies const& from)
+  {
+    for (size_t s = 0; s < into.size(); ++s) {
+      TeamCounts::iterator g = into[s].games.begin();
+      TeamCounts::iterator w = into[s].wins.begin();
+      TeamCounts::iterator w2 = into[s].wins_sq.begin();
+      TeamHistograms::iterator h = into[s].games_hist.begin();
+      TeamHistograms::iterator sh = into[s].seed_hist.begin();
+      TeamCounts::const_iterator fg = from[s].games.begin();
+      TeamCounts::const_iterator fw = from[s].wins.begin();
+      TeamCounts::const_iterator fw2 = from[s].wins_sq.begin();
+      TeamHistograms::const_iterator fh = from[s].games_hist.begin();
+      TeamHistograms::const_iterator fsh = from[s].seed_hist.begin();
+      for (; g != into[s].games.end(); ++g, ++w, ++w2, ++h, ++sh, ++fg, ++fw, ++fw2, ++fh, ++fsh) {
+        g->second += fg->second;
+        w->second += fw->second;
+        w2->second += fw2->second;
+        for (size_t k = 0; k < h->second.size(); ++k) {
+          h->second[k] += fh->second[k];
+        }
+        for (size_t k = 0; k < sh->second.size(); ++k) {
+          sh->second[k] += fsh->second[k];
+        }
+      }
+      for (size_t r = 0; r < into[s].replicate_wins.size(); ++r) {
+        TeamCounts::const_iterator fr = from[s].replicate_wins[r].begin();
+        for (auto it = into[s].replicate_wins[r].begin(); it != into[s].replicate_wins[r].end(); ++it, ++fr) {
+          it->second += fr->second;
+        }
+      }
+      for (size_t p = 0; p < into[s].player_points.size(); ++p) {
+        into[s].player_points[p] += from[s].player_points[p];
+        into[s].player_points_sq[p] += from[s].player_points_sq[p];
+      }
+      for (size_t p = 0; p < into[s].player_sketches.size(); ++p) {
+        into[s].player_sketches[p].Merge(from[s].player_sketches[p]);
+      }
+    }
+  }
+}
+
+bool WriteCheckpoint(std::string const& file, CheckpointKey const& key, long long first_run, long long next_run, PlayoffTallies const& tallies)
+{
+  // Write next to the real file and swap it in, so getting killed mid-write can't lose the last one
+  std::string temp = file + ".tmp";
+  {
+    std::ofstream out(temp.c_str(), std::ios::binary);
+    out.write(kMagic, sizeof(kMagic));
+    Write(out, kVersion);
+    Write(out, key.seed);
+    Write(out, key.data_hash);
+    Write(out, key.runs);
+    Write(out, first_run);
+    Write(out, next_run);
+    Write(out, static_cast<unsigned>(tallies.size()));
+
+    for (auto it = tallies.begin(); it != tallies.end(); ++it) {
+      Write(out, static_cast<unsigned>(it->games.size()));
+      TeamCounts::const_iterator w = it->wins.begin();
+      TeamCounts::const_iterator w2 = it->wins_sq.begin();
+      TeamHistograms::const_iterator h = it->games_hist.begin();
+      TeamHistograms::const_iterator sh = it->seed_hist.begin();
+      for (auto g = it->games.begin(); g != it->games.end(); ++g, ++w, ++w2, ++h, ++sh) {
+        Write(out, g->second);
+        Write(out, w->second);
+        Write(out, w2->second);
+        out.write(reinterpret_cast<char const*>(&h->second[0]), h->second.size() * sizeof(double));
+        out.write(reinterpret_cast<char const*>(&sh->second[0]), sh->second.size() * sizeof(double));
+      }
+
+      Write(out, static_cast<unsigned>(it->replicate_wins.size()));
+      for (auto r = it->replicate_wins.begin(); r != it->replicate_wins.end(); ++r) {
+        for (auto w = r->begin(); w != r->end(); ++w) {
+          Write(out, w->second);
+        }
+      }
+
+      Write(out, static_cast<unsigned>(it->player_points.size()));
+      if (!it->player_points.empty()) {
+        out.write(reinterpret_cast<char const*>(&it->player_points[0]), it->player_points.size() * sizeof(double));
+        out.write(reinterpret_cast<char const*>(&it->player_points_sq[0]), it->player_points_sq.size() * sizeof(double));
+      }
+      Write(out, static_cast<unsigned>(it->player_sketches.size()));
+      for (auto k = it->player_sketches.begin(); k != it->player_sketches.end(); ++k) {
+        k->Write(out);
+      }
+    }
+
+    if (!out) {
+      std::cout << "Couldn't write checkpoint " << temp << std::endl;
+      return false;
+    }
+  }
+
+  std::remove(file.c_str());
+  return std::rename(temp.c_str(), file.c_str()) == 0;
+}
+
+bool ReadCheckpoint(std::string const& file, CheckpointKey const& key, long long& first_run, long long& next_run, PlayoffTallies& tallies)
+{
+  std::ifstream in(file.c_str(), std::ios::binary);
+  if (!in) {
+    return false;
+  }
+
+  char magic[4];
+  unsigned version;
+  CheckpointKey saved;
+  unsigned sets;
+  if (!in.read(magic, sizeof(magic)) || memcmp(magic, kMagic, sizeof(magic)) ||
+      !Read(in, version) || version != kVersion) {
+    std::cout << file << " isn't a checkpoint we can read" << std::endl;
+    return false;
+  }
+
+  Read(in, saved.seed);
+  Read(in, saved.data_hash);
+  Read(in, saved.runs);
+  Read(in, first_run);
+  Read(in, next_run);
+  Read(in, sets);
+
+  if (saved.seed != key.seed || saved.data_hash != key.data_hash || saved.runs != key.runs || sets != tallies.size()) {
+    std::cout << file << " is from a different job (seed, data or run count changed)" << std::endl;
+    return false;
+  }
+
+  for (auto it = tallies.begin(); it != tallies.end(); ++it) {
+    unsigned teams;
+    if (!Read(in, teams) || teams != it->games.size() || teams != it->wins.size() || teams != it->wins_sq.size() || teams != it->games_hist.size() || teams != it->seed_hist.size()) {
+      std::cout << file << " has a different set of teams" << std::endl;
+      return false;
+    }
+    TeamCounts::iterator w = it->wins.begin();
+    TeamCounts::iterator w2 = it->wins_sq.begin();
+    TeamHistograms::iterator h = it->games_hist.begin();
+    TeamHistograms::iterator sh = it->seed_hist.begin();
+    for (auto g = it->games.begin(); g != it->games.end(); ++g, ++w, ++w2, ++h, ++sh) {
+      Read(in, g->second);
+      Read(in, w->second);
+      Read(in, w2->second);
+      in.read(reinterpret_cast<char*>(&h->second[0]), h->second.size() * sizeof(double));
+      in.read(reinterpret_cast<char*>(&sh->second[0]), sh->second.size() * sizeof(double));
+    }
+
+    unsigned replicates;
+    if (!Read(in, replicates) || replicates != it->replicate_wins.size()) {
+      std::cout << file << " was run with a different number of replicates" << std::endl;
+      return false;
+    }
+    for (auto r = it->replicate_wins.begin(); r != it->replicate_wins.end(); ++r) {
+      for (auto w = r->begin(); w != r->end(); ++w) {
+        Read(in, w->second);
+      }
+    }
+
+    unsigned players;
+    if (!Read(in, players) || players != it->player_points.size()) {
+      std::cout << file << " was run with a different player model" << std::endl;
+      return false;
+    }
+    if (players) {
+      in.read(reinterpret_cast<char*>(&it->player_points[0]), players * sizeof(double));
+      in.read(reinterpret_cast<char*>(&it->player_points_sq[0]), players * sizeof(double));
+    }
+    unsigned sketches;
+    if (!Read(in, sketches) || sketches != it->player_sketches.size()) {
+      std::cout << file << " was run with a different player model" << std::endl;
+      return false;
+    }
+    for (auto k = it->player_sketches.begin(); k != it->player_sketches.end(); ++k) {
+      if (!k->Read(in)) break;
+    }
+  }
+
+  return !!in;
+}
+
+long long MergeCheckpoints(std::vector<std::string> const& files, CheckpointKey const& key, PlayoffTallies& tallies)
+{
+  PlayoffTallies zero = tallies;
+  std::vector<std::pair<long long, long long> > ranges;
+
+  for (auto it = files.begin(); it != files.end(); ++it) {
+    PlayoffTallies partial = zero;
+    long long first_run = 0;
+    long long next_run = 0;
+    if (!ReadCheckpoint(*it, key, first_run, next_run, partial)) {
+      std::cout << "Couldn't merge " << *it << std::endl;
+      return -1;
+    }
+    AddTallies(tallies, partial);
+    ranges.push_back(std::make_pair(first_run, next_run));
+  }
+
+  // Shards have to fit together end to end, otherwise we'd be counting runs twice or missing some
+  std::sort(ranges.begin(), ranges.end());
+  long long covered = 0;
+  for (auto it = ranges.begin(); it != ranges.end(); ++it) {
+    if (it->first != covered) {
+      std::cout << "Partials don't line up -- expected one starting at run " << covered << " but got " << it->first << std::endl;
+      return -1;
+    }
+    covered = it->second;
+  }
+
+  if (covered != key.runs) {
+    std::cout << "Partials only cover " << covered << " of " << key.runs << " runs" << std::endl;
+    return -1;
+  }
+
+  return covered;
+}
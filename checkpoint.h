@@ -0,0 +1,52 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "kll.h"
+#include "types.h"
+
+// Most playoff games a team can count in one run (4 wins in each of 4 rounds)
+const int kMaxRunGames = 16;
+
+// Running totals for one set of teams, each run counted with its importance weight
+// Normally every weight is 1, and whole-number counts in a double are exact up to 2^53, so a job that's
+// stopped and resumed, or split up and merged, adds up to exactly the same thing
+typedef std::map<Team, double>                 TeamCounts;
+typedef std::vector<double>                    Histogram;
+typedef std::map<Team, Histogram>              TeamHistograms;
+
+struct PlayoffTally
+{
+  TeamCounts games;
+  TeamCounts wins;
+  TeamCounts wins_sq;        // sum of squared weights for each team's wins, for the importance sampling variance
+  TeamHistograms games_hist; // how many runs each team finished with 0..kMaxRunGames games
+  TeamHistograms seed_hist;  // how many runs each team got each playoff seed (0 for missing out) when the season's simulated too
+  std::vector<TeamCounts> replicate_wins; // wins split up by replicate, for error estimates
+  std::vector<double> player_points;    // per player, sum of points over runs with the player model on (empty otherwise)
+  std::vector<double> player_points_sq; // and the sum of squares, for the spread
+  std::vector<KllSketch> player_sketches; // and the distribution, when every run counts the same (empty with importance sampling)
+};
+
+typedef std::vector<PlayoffTally> PlayoffTallies;
+
+// Identifies the job a checkpoint belongs to, so we never resume or merge somebody else's
+struct CheckpointKey
+{
+  unsigned seed;
+  unsigned data_hash;
+  long long runs;
+};
+
+// A checkpoint covers runs [first_run, next_run) of the job -- a whole job starts at 0, a shard somewhere in the middle
+// Every run has its own random streams keyed on the run index, so the next run to do is the whole RNG position
+// and the tallies are all we need to pick up exactly where we stopped
+bool WriteCheckpoint(std::string const& file, CheckpointKey const& key, long long first_run, long long next_run, PlayoffTallies const& tallies);
+
+// Tallies need to come in already holding every team (at zero), since only counts are stored
+bool ReadCheckpoint(std::string const& file, CheckpointKey const& key, long long& first_run, long long& next_run, PlayoffTallies& tallies);
+
+// Add up partial results from shards of the same job -- they have to cover every run exactly once
+// Returns the number of runs covered, or -1 if something doesn't line up
+long long MergeCheckpoints(std::vector<std::string> const& files, CheckpointKey const& key, PlayoffTallies& tallies);
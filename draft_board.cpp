@@ -0,0 +1,143 @@
+#include <algorithm>
+
+#include "draft_board.h"
+
+namespace
+{
+  // Highest value first, then by ranking
+  bool ByValue(std::pair<size_t, float> const& a, std::pair<size_t, float> const& b)
+  {
+    if (a.second != b.second) return a.second > b.second;
+    return a.first < b.first;
+  }
+}
+
+void DraftBoard::Reset(PlayerPointsList const& ranked_players, std::map<std::string, int> const& drafted)
+{
+  ranked = &ranked_players;
+  positions.clear();
+  position_of.assign(ranked_players.size(), static_cast<Position*>(NULL));
+  slot_of.assign(ranked_players.size(), 0);
+  available.assign(ranked_players.size(), true);
+  taken = 0;
+
+  for (size_t p = 0; p < ranked_players.size(); ++p) {
+    Position& position = positions[ranked_players[p].first.pos];
+    slot_of[p] = position.players.size();
+    position.players.push_back(p);
+  }
+
+  for (auto it = positions.begin(); it != positions.end(); ++it) {
+    Position& position = it->second;
+    for (size_t p = 0; p < position.players.size(); ++p) {
+      position_of[position.players[p]] = &position;
+    }
+
+    // Every player's available -- a Fenwick tree of all ones covers (i & -i) players at node i
+    position.tree.assign(position.players.size() + 1, 0);
+    for (size_t i = 1; i < position.tree.size(); ++i) {
+      position.tree[i] = static_cast<int>(i & (0 - i));
+    }
+    position.left = static_cast<int>(position.players.size());
+
+    std::map<std::string, int>::const_iterator d = drafted.find(it->first);
+    position.to_draft = d != drafted.end() ? d->second : position.left;
+    Revalue(position);
+  }
+}
+
+void DraftBoard::Update(Position& position, size_t slot, int change)
+{
+  for (size_t i = slot + 1; i < position.tree.size(); i += i & (0 - i)) {
+    position.tree[i] += change;
+  }
+  position.left += change;
+}
+
+// Walk down the tree from the top power of two, skipping whole blocks with k or fewer available in them
+size_t DraftBoard::Select(Position const& position, size_t k) const
+{
+  if (k >= static_cast<size_t>(position.left)) return npos;
+
+  size_t step = 1;
+  while (step * 2 < position.tree.size()) step *= 2;
+
+  size_t at = 0;
+  size_t remaining = k + 1;
+  for (; step > 0; step /= 2) {
+    size_t next = at + step;
+    if (next < position.tree.size() && static_cast<size_t>(position.tree[next]) < remaining) {
+      at = next;
+      remaining -= position.tree[next];
+    }
+  }
+  return position.players[at];
+}
+
+// The replacement player is whoever's next once the rest of the position's picks are made
+void DraftBoard::Revalue(Position& position)
+{
+  size_t replacement = Select(position, static_cast<size_t>(std::max(0, position.to_draft)));
+  position.replacement = replacement != npos ? (*ranked)[replacement].second : 0.f;
+}
+
+bool DraftBoard::Take(size_t player)
+{
+  if (player >= available.size() || !available[player]) return false;
+  available[player] = false;
+  ++taken;
+
+  Position& position = *position_of[player];
+  Update(position, slot_of[player], -1);
+  --position.to_draft;
+  Revalue(position);
+  return true;
+}
+
+bool DraftBoard::Return(size_t player)
+{
+  if (player >= available.size() || available[player]) return false;
+  available[player] = true;
+  --taken;
+
+  Position& position = *position_of[player];
+  Update(position, slot_of[player], 1);
+  ++position.to_draft;
+  Revalue(position);
+  return true;
+}
+
+size_t DraftBoard::Nth(std::string const& pos, size_t k) const
+{
+  std::map<std::string, Position>::const_iterator it = positions.find(pos);
+  return it != positions.end() ? Select(it->second, k) : npos;
+}
+
+std::vector<size_t> DraftBoard::Top(std::string const& pos, size_t count) const
+{
+  std::vector<size_t> top;
+  for (size_t k = 0; k < count; ++k) {
+    size_t player = Nth(pos, k);
+    if (player == npos) break;
+    top.push_back(player);
+  }
+  return top;
+}
+
+// Within a position value over replacement goes in the same order as points, so the overall best are a merge of
+// the top few at each position -- nobody past the first count anywhere gets looked at
+std::vector<std::pair<size_t, float> > DraftBoard::Recommend(size_t count) const
+{
+  std::vector<std::pair<size_t, float> > best;
+  for (auto it = positions.begin(); it != positions.end(); ++it) {
+    for (size_t k = 0; k < count; ++k) {
+      size_t player = Select(it->second, k);
+      if (player == npos) break;
+      best.push_back(std::make_pair(player, (*ranked)[player].second - it->second.replacement));
+    }
+  }
+
+  std::sort(best.begin(), best.end(), ByValue);
+  if (best.size() > count) best.resize(count);
+  return best;
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "types.h"
+
+// Players still on the board during a draft. Each position keeps its players in ranked order with a
+// Fenwick tree of which ones are still available, so taking a player, putting one back, and finding the
+// k-th best left at a position are all O(log n).
+//
+// Players are valued over replacement: their points minus the points of the best player at the same position
+// who'll still be there once every roster's filled. Taking a player only moves the replacement level at their
+// own position, so that's the only one that gets worked out again.
+class DraftBoard
+{
+public:
+  static const size_t npos = static_cast<size_t>(-1);
+
+  DraftBoard() : ranked(NULL), taken(0) {}
+
+  // ranked has to be best first, and stays indexed the same way. drafted is how many players at each
+  // position get taken over the whole draft (teams times roster spots) -- positions not in it are valued on points alone.
+  void Reset(PlayerPointsList const& ranked, std::map<std::string, int> const& drafted);
+
+  // False if the player's already gone (or back)
+  bool Take(size_t player);
+  bool Return(size_t player);
+
+  bool Available(size_t player) const { return available[player]; }
+  size_t Taken() const { return taken; }
+
+  // The k-th (from 0) best player still available at pos, or npos
+  size_t Nth(std::string const& pos, size_t k) const;
+
+  // Best count players still available, by value over replacement, as (player, value)
+  std::vector<std::pair<size_t, float> > Recommend(size_t count) const;
+
+  // Best count still available at one position, by points
+  std::vector<size_t> Top(std::string const& pos, size_t count) const;
+
+private:
+  struct Position
+  {
+    std::vector<size_t> players; // in ranked order
+    std::vector<int> tree;       // Fenwick tree over players, 1 for each one still available
+    int left;                    // still available
+    int to_draft;                // still to be taken before the draft's done
+    float replacement;           // points of the replacement level player
+  };
+
+  void Update(Position& position, size_t slot, int change);
+  size_t Select(Position const& position, size_t k) const;
+  void Revalue(Position& position);
+
+  PlayerPointsList const* ranked;
+  std::map<std::string, Position> positions;
+  std::vector<Position*> position_of; // for each player
+  std::vector<size_t> slot_of;        // and where they are in it
+  std::vector<bool> available;
+  size_t taken;
+};
@@ -0,0 +1,378 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "series_rng.h"
+#include "types.h"
+
+// Games in the regular season, for turning records into rates
+const int kGameTotal = 48;
+
+// A series gets played by two policies, both picked at compile time so the game loop has no
+// indirection in it and a policy that does nothing (like no home ice) compiles away entirely:
+//
+//   Model   -- how one game goes. Model::Start(t1, t2, setup) works out whatever it needs once per series,
+//              then Model::FirstWins(series, edge, eng) plays a game, with edge added to the first team's chances
+//   HomeIce -- HomeIce::Edge(game, first_home) is the first team's edge in game number game (from 0),
+//              given whether the first team has home ice in the series
+//
+// Models also give Model::WinProb(series), the chance of a game on neutral ice
+//
+// Every series is best of seven. Sampling whole series, the exact odds, the run index, the checkpointed
+// games histograms and 2-2-1-1-1 home ice all count on first to 4, so the format isn't a policy.
+
+struct GameTable;
+
+// Whatever a simulation has worked out ahead of time for the models to start series from
+struct SeriesSetup
+{
+  SeriesSetup() : table(NULL) {}
+
+  GameTable const* table; // every matchup's odds for PoissonTableModel, NULL if they haven't been built
+};
+
+// The original model: pick a random game out of each team's record, and keep going until exactly one
+// of them is a win. Works out to the log5 chance, with overtime losses counted as losses.
+struct RecordModel
+{
+  struct Series
+  {
+    int won1;
+    int won2;
+    double p; // only needed to apply an edge
+  };
+
+  static Series Start(Team const& t1, Team const& t2, SeriesSetup const&)
+  {
+    Series series;
+    series.won1 = t1.won;
+    series.won2 = t2.won;
+    double p1 = static_cast<double>(t1.won) / kGameTotal;
+    double p2 = static_cast<double>(t2.won) / kGameTotal;
+    double t1_only = p1 * (1 - p2);
+    double t2_only = p2 * (1 - p1);
+    series.p = t1_only + t2_only > 0 ? t1_only / (t1_only + t2_only) : 0.5;
+    return series;
+  }
+
+  static double WinProb(Series const& series)
+  {
+    return series.p;
+  }
+
+  static bool FirstWins(Series const& series, double edge, SeriesRng& eng)
+  {
+    bool t1win;
+    for (;;) {
+      // Check if each team won -- if both won or both lost it doesn't make sense, so start again
+      t1win = eng.Roll(kGameTotal) <= series.won1;
+      bool t2win = eng.Roll(kGameTotal) <= series.won2;
+      if (t1win != t2win) break;
+    }
+
+    // Push the result over with just enough chance to move it by edge
+    if (edge > 0 && !t1win && series.p < 1) {
+      t1win = eng.Uniform() < edge / (1 - series.p);
+    } else if (edge < 0 && t1win && series.p > 0) {
+      t1win = !(eng.Uniform() < -edge / series.p);
+    }
+    return t1win;
+  }
+};
+
+// Bradley-Terry with each team's strength as the odds of its points percentage, so an overtime loss
+// counts as half a win. Same shape as the record model, but one draw a game.
+struct BradleyTerryModel
+{
+  struct Series
+  {
+    double p;
+  };
+
+  static double Strength(Team const& t)
+  {
+    double won = t.won + 0.5 * t.otlost;
+    double lost = t.lost + 0.5 * t.otlost;
+    return (won + 0.5) / (lost + 0.5);
+  }
+
+  static Series Start(Team const& t1, Team const& t2, SeriesSetup const&)
+  {
+    Series series;
+    double s1 = Strength(t1);
+    double s2 = Strength(t2);
+    series.p = s1 / (s1 + s2);
+    return series;
+  }
+
+  static double WinProb(Series const& series)
+  {
+    return series.p;
+  }
+
+  static bool FirstWins(Series const& series, double edge, SeriesRng& eng)
+  {
+    return eng.Uniform() < std::min(1.0, std::max(0.0, series.p + edge));
+  }
+};
+
+// Goals per team per game across the league
+const double kLeagueGoals = 2.6;
+
+// Expected goals for each side in a game between t1 and t2
+// Uses goals for and against when we have them (attack times the other side's defence, over the league average),
+// otherwise gives each side the league average scaled by the fourth root of its Bradley-Terry odds k (or 1/k).
+// The rates then differ by a factor of sqrt(k), which is what makes a game's win chance come out at about
+// the Bradley-Terry k / (1 + k) -- within half a percent up to k = 3. A ratio of k would overshoot it by far.
+inline void GoalRates(Team const& t1, Team const& t2, double& rate1, double& rate2)
+{
+  int gp1 = t1.won + t1.lost + t1.otlost;
+  int gp2 = t2.won + t2.lost + t2.otlost;
+  if (t1.gf > 0 && t1.ga > 0 && t2.gf > 0 && t2.ga > 0 && gp1 > 0 && gp2 > 0) {
+    rate1 = (static_cast<double>(t1.gf) / gp1) * (static_cast<double>(t2.ga) / gp2) / kLeagueGoals;
+    rate2 = (static_cast<double>(t2.gf) / gp2) * (static_cast<double>(t1.ga) / gp1) / kLeagueGoals;
+  } else {
+    double k = BradleyTerryModel::Strength(t1) / BradleyTerryModel::Strength(t2);
+    rate1 = kLeagueGoals * std::pow(k, 0.25);
+    rate2 = kLeagueGoals * std::pow(k, -0.25);
+  }
+}
+
+// Chance the first side scores more in regulation, and the chance it's tied
+inline void RegulationOdds(double rate1, double rate2, double& win, double& tie)
+{
+  const int kMaxGoals = 25;
+  double pmf1[kMaxGoals];
+  double pmf2[kMaxGoals];
+  pmf1[0] = std::exp(-rate1);
+  pmf2[0] = std::exp(-rate2);
+  for (int g = 1; g < kMaxGoals; ++g) {
+    pmf1[g] = pmf1[g - 1] * rate1 / g;
+    pmf2[g] = pmf2[g - 1] * rate2 / g;
+  }
+
+  win = 0;
+  tie = 0;
+  double below2 = 0; // chance the second side scores fewer than g
+  for (int g = 0; g < kMaxGoals; ++g) {
+    win += pmf1[g] * below2;
+    tie += pmf1[g] * pmf2[g];
+    below2 += pmf2[g];
+  }
+}
+
+// Goals for each side from a Poisson process, with sudden-death overtime on a tie
+// Draws every goal, so it's the slow one -- PoissonTableModel gets the same regulation odds from a lookup
+struct PoissonGoalsModel
+{
+  struct Series
+  {
+    double rate1;
+    double rate2;
+  };
+
+  static Series Start(Team const& t1, Team const& t2, SeriesSetup const&)
+  {
+    Series series;
+    GoalRates(t1, t2, series.rate1, series.rate2);
+    return series;
+  }
+
+  // Chance of more goals, plus the chance of a tie times the chance of scoring first after it
+  static double WinProb(Series const& series)
+  {
+    double win;
+    double tie;
+    RegulationOdds(series.rate1, series.rate2, win, tie);
+    return win + tie * series.rate1 / (series.rate1 + series.rate2);
+  }
+
+  // Knuth's method -- multiply uniforms until the product drops under e^-rate
+  static int Goals(double rate, SeriesRng& eng)
+  {
+    double limit = std::exp(-rate);
+    double product = eng.Uniform();
+    int goals = 0;
+    while (product > limit) {
+      product *= eng.Uniform();
+      ++goals;
+    }
+    return goals;
+  }
+
+  static bool FirstWins(Series const& series, double edge, SeriesRng& eng)
+  {
+    // An edge shifts scoring towards the first team by roughly that much win probability
+    double rate1 = series.rate1 * (1 + 2 * edge);
+    double rate2 = series.rate2 * (1 - 2 * edge);
+    int goals1 = Goals(rate1, eng);
+    int goals2 = Goals(rate2, eng);
+    if (goals1 != goals2) return goals1 > goals2;
+
+    // Whoever scores first in overtime
+    return eng.Uniform() * (rate1 + rate2) < rate1;
+  }
+};
+
+// How a game between two teams can go, worked out ahead of time
+struct GameOdds
+{
+  float win_regulation;
+  float win_overtime;
+  float lose_overtime; // whatever's left is a loss in regulation
+};
+
+// Every pair of teams' GameOdds, indexed by record id, so playing a game is one lookup and one draw
+struct GameTable
+{
+  GameTable() : teams(0) {}
+
+  GameOdds const& At(int record1, int record2) const
+  {
+    return odds[static_cast<size_t>(record1) * teams + record2];
+  }
+
+  int teams;
+  std::vector<GameOdds> odds;
+};
+
+// Poisson goals in regulation, then overtime decided by how often each team loses past regulation:
+// a team's overtime win rate is one minus its overtime losses over the overtime games it would have played
+// at the league rate, and the two rates meet log5-style. Build the table with every team (all scenarios)
+// and put it in the setup before playing.
+struct PoissonTableModel
+{
+  typedef GameOdds Series;
+
+  static GameTable Build(std::vector<Teams> const& team_sets)
+  {
+    // Share of games that went past regulation -- every one left exactly one overtime loss
+    int otlost = 0;
+    int played = 0;
+    int records = 0;
+    for (auto s = team_sets.begin(); s != team_sets.end(); ++s) {
+      for (auto it = s->begin(); it != s->end(); ++it) {
+        records = std::max(records, it->record + 1);
+      }
+    }
+    std::vector<Team const*> by_record(records, static_cast<Team const*>(NULL));
+    for (auto s = team_sets.begin(); s != team_sets.end(); ++s) {
+      for (auto it = s->begin(); it != s->end(); ++it) {
+        if (by_record[it->record]) continue;
+        by_record[it->record] = &*it;
+        if (s == team_sets.begin()) {
+          otlost += it->otlost;
+          played += it->won + it->lost + it->otlost;
+        }
+      }
+    }
+    double overtime = played ? 2.0 * otlost / played : 0;
+
+    std::vector<double> ot_win(records, 0.5);
+    for (int r = 0; r < records; ++r) {
+      if (!by_record[r]) continue;
+      Team const& t = *by_record[r];
+      double ot_games = overtime * (t.won + t.lost + t.otlost);
+      if (ot_games > 0) ot_win[r] = std::min(0.9, std::max(0.1, 1 - t.otlost / ot_games));
+    }
+
+    GameTable table;
+    table.teams = records;
+    table.odds.assign(static_cast<size_t>(records) * records, GameOdds());
+    for (int r1 = 0; r1 < records; ++r1) {
+      for (int r2 = 0; r2 < records; ++r2) {
+        if (!by_record[r1] || !by_record[r2]) continue;
+        double rate1;
+        double rate2;
+        double win;
+        double tie;
+        GoalRates(*by_record[r1], *by_record[r2], rate1, rate2);
+        RegulationOdds(rate1, rate2, win, tie);
+        double p1 = ot_win[r1] * (1 - ot_win[r2]);
+        double p2 = ot_win[r2] * (1 - ot_win[r1]);
+        double first_ot = p1 + p2 > 0 ? p1 / (p1 + p2) : 0.5;
+
+        GameOdds& odds = table.odds[static_cast<size_t>(r1) * records + r2];
+        odds.win_regulation = static_cast<float>(win);
+        odds.win_overtime = static_cast<float>(tie * first_ot);
+        odds.lose_overtime = static_cast<float>(tie * (1 - first_ot));
+      }
+    }
+    return table;
+  }
+
+  static Series Start(Team const& t1, Team const& t2, SeriesSetup const& setup)
+  {
+    return setup.table->At(t1.record, t2.record);
+  }
+
+  static double WinProb(Series const& series)
+  {
+    return series.win_regulation + series.win_overtime;
+  }
+
+  static bool FirstWins(Series const& series, double edge, SeriesRng& eng)
+  {
+    return eng.Uniform() < series.win_regulation + series.win_overtime + edge;
+  }
+};
+
+// Home ice goes to the higher seed within a conference. The final has one team from each, so it
+// goes on the regular season instead: points, then fewer games played, then wins, like the standings
+inline bool FirstHasHomeIce(Team const& t1, Team const& t2)
+{
+  if (t1.conf == t2.conf) return t1.seed <= t2.seed;
+
+  int points1 = 2 * t1.won + t1.otlost;
+  int points2 = 2 * t2.won + t2.otlost;
+  if (points1 != points2) return points1 > points2;
+  int played1 = t1.won + t1.lost + t1.otlost;
+  int played2 = t2.won + t2.lost + t2.otlost;
+  if (played1 != played2) return played1 < played2;
+  return t1.won >= t2.won;
+}
+
+// Every game on neutral ice
+struct NoHomeIce
+{
+  static double Edge(int, bool) { return 0; }
+};
+
+// 2-2-1-1-1: the team with home ice is home for games 1, 2, 5 and 7, with an edge of EdgeBp hundredths of a percent
+template <int EdgeBp>
+struct HomeIce2211
+{
+  static double Edge(int game, bool first_home)
+  {
+    bool home = (game == 0 || game == 1 || game == 4 || game == 6) == first_home;
+    return (home ? EdgeBp : -EdgeBp) / 10000.0;
+  }
+};
+
+// Play a series out game by game from however many each team has already won, first to 4
+template <class Model, class HomeIce>
+GameSplit PlaySeries(Matchup const& matchup, GameSplit const& start, SeriesSetup const& setup, SeriesRng& eng)
+{
+  typename Model::Series series = Model::Start(matchup.first, matchup.second, setup);
+  bool first_home = FirstHasHomeIce(matchup.first, matchup.second);
+  GameSplit result = start;
+  while (result.first < 4 && result.second < 4) {
+    bool first = Model::FirstWins(series, HomeIce::Edge(result.first + result.second, first_home), eng);
+    result.first  += first;
+    result.second += !first;
+  }
+  return result;
+}
+
+// Chance of the first team winning one game on neutral ice, for the paths that sample whole series at once
+template <class Model>
+double ModelWinProb(Team const& t1, Team const& t2, SeriesSetup const& setup)
+{
+  return Model::WinProb(Model::Start(t1, t2, setup));
+}
+
+// One compiled combination of policies
+typedef GameSplit (*SeriesSimulator)(Matchup const& matchup, GameSplit const& start, SeriesSetup const& setup, SeriesRng& eng);
+typedef double (*WinProbFunction)(Team const& t1, Team const& t2, SeriesSetup const& setup);
@@ -0,0 +1,194 @@
+#include <algorithm>
+#include <cmath>
+#include <istream>
+#include <ostream>
+
+#include "kll.h"
+
+namespace
+{
+  // Largest share of the capacity each level below the top gets, going down
+  const double kShrink = 2.0 / 3.0;
+
+  // Smallest capacity for a level -- any less and the bottom levels get compressed every couple of values
+  const int kMinCapacity = 8;
+
+  template <typename T>
+  void Write(std::ostream& out, T const& value)
+  {
+    out.write(reinterpret_cast<char const*>(&value), sizeof(value));
+  }
+
+  template <typename T>
+  bool Read(std::istream& in, T& value)
+  {
+    return !!in.read(reinterpret_cast<char*>(&value), sizeof(value));
+  }
+
+  bool ByValue(std::pair<float, long long> const& a, std::pair<float, long long> const& b)
+  {
+    return a.first < b.first;
+  }
+}
+
+KllSketch::KllSketch(int k) : k(k), n(0), coin(0x9e3779b9u), levels(1), stored(0), limit(0)
+{
+  Recount();
+}
+
+// Capacities only change when a level gets added, so this isn't needed on every Add
+void KllSketch::Recount()
+{
+  stored = 0;
+  limit = 0;
+  capacity.resize(levels.size());
+  for (size_t h = 0; h < levels.size(); ++h) {
+    size_t depth = levels.size() - 1 - h;
+    capacity[h] = std::max(kMinCapacity, static_cast<int>(std::ceil(k * std::pow(kShrink, static_cast<double>(depth)))));
+    stored += levels[h].size();
+    limit += capacity[h];
+  }
+}
+
+void KllSketch::Add(float value)
+{
+  levels[0].push_back(value);
+  ++n;
+  if (++stored >= limit) {
+    Compress();
+  }
+}
+
+void KllSketch::Merge(KllSketch const& other)
+{
+  if (levels.size() < other.levels.size()) {
+    levels.resize(other.levels.size());
+  }
+  for (size_t h = 0; h < other.levels.size(); ++h) {
+    size_t mine = levels[h].size();
+    levels[h].insert(levels[h].end(), other.levels[h].begin(), other.levels[h].end());
+    if (h > 0) {
+      std::inplace_merge(levels[h].begin(), levels[h].begin() + mine, levels[h].end());
+    }
+  }
+  n += other.n;
+  Recount();
+  while (stored >= limit) {
+    Compress();
+  }
+}
+
+void KllSketch::Compress()
+{
+  for (size_t h = 0; h < levels.size(); ++h) {
+    if (levels[h].size() < capacity[h]) continue;
+
+    bool grew = h + 1 == levels.size();
+    if (grew) {
+      levels.push_back(std::vector<float>());
+    }
+
+    // Only the bottom level takes values as they come -- everything above it is kept sorted
+    std::vector<float>& level = levels[h];
+    if (h == 0) {
+      std::sort(level.begin(), level.end());
+    }
+
+    // An odd one out stays behind, so what moves up is a whole number of pairs
+    float leftover = level.back();
+    bool odd = level.size() % 2 == 1;
+    size_t pairs = level.size() / 2;
+
+    // xorshift for the coin
+    coin ^= coin << 13;
+    coin ^= coin >> 17;
+    coin ^= coin << 5;
+    size_t offset = coin & 1;
+
+    // Every other value, merged in with what's already sorted on the level above
+    std::vector<float>& above = levels[h + 1];
+    scratch.clear();
+    for (size_t i = 0; i < pairs; ++i) {
+      scratch.push_back(level[2 * i + offset]);
+    }
+    size_t had = above.size();
+    above.insert(above.end(), scratch.begin(), scratch.end());
+    std::inplace_merge(above.begin(), above.begin() + had, above.end());
+    level.clear();
+    if (odd) level.push_back(leftover);
+
+    // One level at a time is enough to get back under
+    if (grew) {
+      Recount();
+    } else {
+      stored -= pairs;
+    }
+    return;
+  }
+}
+
+float KllSketch::Quantile(double q) const
+{
+  std::vector<std::pair<float, long long> > weighted;
+  long long total = 0;
+  for (size_t h = 0; h < levels.size(); ++h) {
+    for (auto it = levels[h].begin(); it != levels[h].end(); ++it) {
+      weighted.push_back(std::make_pair(*it, 1LL << h));
+      total += 1LL << h;
+    }
+  }
+  if (weighted.empty()) return 0.f;
+
+  std::sort(weighted.begin(), weighted.end(), ByValue);
+  double target = q * total;
+  long long seen = 0;
+  for (auto it = weighted.begin(); it != weighted.end(); ++it) {
+    seen += it->second;
+    if (seen >= target) return it->first;
+  }
+  return weighted.back().first;
+}
+
+double KllSketch::Rank(float value) const
+{
+  long long below = 0;
+  long long total = 0;
+  for (size_t h = 0; h < levels.size(); ++h) {
+    for (auto it = levels[h].begin(); it != levels[h].end(); ++it) {
+      if (*it <= value) below += 1LL << h;
+      total += 1LL << h;
+    }
+  }
+  return total ? static_cast<double>(below) / total : 0;
+}
+
+void KllSketch::Write(std::ostream& out) const
+{
+  ::Write(out, k);
+  ::Write(out, n);
+  ::Write(out, coin);
+  ::Write(out, static_cast<unsigned>(levels.size()));
+  for (auto it = levels.begin(); it != levels.end(); ++it) {
+    ::Write(out, static_cast<unsigned>(it->size()));
+    if (!it->empty()) {
+      out.write(reinterpret_cast<char const*>(&(*it)[0]), it->size() * sizeof(float));
+    }
+  }
+}
+
+bool KllSketch::Read(std::istream& in)
+{
+  unsigned count = 0;
+  if (!::Read(in, k) || !::Read(in, n) || !::Read(in, coin) || !::Read(in, count) || count == 0 || count > 64) {
+    return false;
+  }
+  levels.assign(count, std::vector<float>());
+  for (auto it = levels.begin(); it != levels.end(); ++it) {
+    unsigned size = 0;
+    if (!::Read(in, size) || size > (1u << 20)) return false;
+    it->resize(size);
+    if (size) in.read(reinterpret_cast<char*>(&(*it)[0]), size * sizeof(float));
+  }
+  Recount();
+  return !!in;
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <iosfwd>
+#include <vector>
+
+// KLL quantile sketch (Karnin, Lang & Liberty) -- keeps a few hundred values no matter how many go in,
+// with rank error around 1.5% at the default size. Sketches of different runs merge into one of all of them.
+//
+// Values live in levels of compactors, where each value at level h stands for 2^h of the originals. When the
+// sketch fills up, the lowest full level gets sorted and every other value moves up a level. Which half moves
+// comes from a coin that's part of the sketch, so the same values in the same order always give the same sketch.
+class KllSketch
+{
+public:
+  explicit KllSketch(int k = 200);
+
+  void Add(float value);
+  void Merge(KllSketch const& other);
+
+  long long Count() const { return n; }
+
+  // Value with about q of the others below it (0 <= q <= 1)
+  float Quantile(double q) const;
+
+  // Share of the values at or below value
+  double Rank(float value) const;
+
+  void Write(std::ostream& out) const;
+  bool Read(std::istream& in);
+
+private:
+  void Recount();
+  void Compress();
+
+  int k;
+  long long n;
+  unsigned coin;
+  std::vector<std::vector<float> > levels;
+  std::vector<size_t> capacity; // how many each level holds before it's compressed
+  std::vector<float> scratch;   // values on their way up a level
+  size_t stored; // values held across every level
+  size_t limit;  // compress once stored gets here -- the sum of the level capacities
+};
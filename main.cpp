@@ -3,6 +3,8 @@
 
 #include "strtk/strtk.hpp"
 
+#include "stat_file.h"
+
 // Last one in the list is the one that will be predicted
 // Currently, use the 2011 regular season and 2013 preseason to "predict" the 2012 season
 static const char* prefixes[] = {
@@ -28,43 +30,51 @@ typedef std::map<std::string, SkaterPerformances>  SkaterStats; // all of a play
 
 typedef std::vector<strtk::token_grid*> TokenGrids;
 
+// The columns we want out of a season dump, wherever they are in it
+struct SkaterLine
+{
+  std::string name;
+  int gp;
+  int pts;
+};
+
+strtk_bind_begin(SkaterLine)
+  strtk_bind_column(name, "name|player")
+  strtk_bind_column(gp, "gp")
+  strtk_bind_column(pts, "pts")
+strtk_bind_end()
+
 void GetSkaterStats(SkaterStats& ss)
 {
   // try skaters first
+  // The season dumps all stay open at once, which mapping them keeps cheap
   TokenGrids skater_data;
+  strtk::token_grid::options options = StatFileOptions();
   for (int i = 0; i < num_prefixes; ++i) {
-    skater_data.push_back(new strtk::token_grid(std::string(prefixes[i]) + 's' + ".csv"));
+    std::string file_name = std::string(prefixes[i]) + 's' + ".csv";
+    skater_data.push_back(new strtk::token_grid(file_name, options));
 
     // Get column locations
-    size_t name_col;
-    size_t gp_col;
-    size_t pts_col;
-    strtk::token_grid::row_type r = skater_data[i]->row(0);
-    for (size_t j = 0; j < r.size(); ++j) {
-      std::string header = r.get<std::string>(j);
-      header.erase(std::remove_if(header.begin(), header.end(), [](unsigned char c){return !::isalnum(c);}));
-      std::transform(header.begin(), header.end(), header.begin(), ::tolower);
-      if (header == "name" || header == "player") {
-        name_col = j;
-      }
-      if (header == "gp") {
-        gp_col = j;
-      }
-      if (header == "pts") {
-        pts_col = j;
-      }
+    strtk::grid_binding<SkaterLine> binding;
+    std::string error;
+    if (!binding.resolve(*skater_data[i], error)) {
+      std::cout << file_name << ": " << error << std::endl;
+      continue;
     }
 
     // Go through all the rows in this data
-    for (size_t j = 1; j < skater_data[i]->row_count(); ++j) {
-      strtk::token_grid::row_type r = skater_data[i]->row(j);
+    for (size_t j = binding.first_row(); j < skater_data[i]->row_count(); ++j) {
+      SkaterLine line;
+      if (!binding.parse(skater_data[i]->row(j), line)) {
+        continue;
+      }
 
       SkaterPerformance sp;
       sp.tag = prefixes[i];
-      sp.gp = r.get<int>(gp_col);
-      sp.pts = r.get<int>(pts_col);
+      sp.gp = line.gp;
+      sp.pts = line.pts;
       sp.ppg = static_cast<double>(sp.pts) / sp.gp;
-      ss[r.get<std::string>(name_col)].push_back(sp);
+      ss[line.name].push_back(sp);
     }
   }
 }
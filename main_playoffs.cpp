@@ -1,41 +1,165 @@
-#include <cassert>
+#include <chrono>
+#include <cmath>
+#include <cstring>
 #include <iomanip>
 #include <fstream>
+#include <functional>
+#include <memory>
 #include <random>
+#include <sstream>
 
 #include "strtk/strtk.hpp"
 
+#include "checkpoint.h"
+#include "draft_board.h"
+#include "game_model.h"
+#include "player_model.h"
+#include "run_index.h"
+#include "scoring.h"
+#include "season.h"
+#include "server.h"
+#include "stat_file.h"
+#include "series_rng.h"
+#include "sobol.h"
 #include "types.h"
 
-std::mt19937 eng;
-const int kGameTotal = 48;
+unsigned base_seed = std::mt19937::default_seed;
 
-struct Team
+// Home teams win about 55% of playoff games
+const int kHomeEdgeBp = 500;
+
+// A game model as the command line knows it, compiled with or without home ice
+struct GameModelChoice
 {
-  std::string name;
-  char conf;
-  int seed;
-  int won;
-  int lost;
-  int otlost;
+  char const* name;
+  bool home_ice;
+  SeriesSimulator simulate;  // game by game
+  WinProbFunction win_prob;  // one neutral-ice game, for sampling whole series at once
+};
+
+const GameModelChoice kGameModels[] = {
+  { "record",  false, &PlaySeries<RecordModel,       NoHomeIce>,                 &ModelWinProb<RecordModel> },
+  { "record",  true,  &PlaySeries<RecordModel,       HomeIce2211<kHomeEdgeBp> >, &ModelWinProb<RecordModel> },
+  { "bt",      false, &PlaySeries<BradleyTerryModel, NoHomeIce>,                 &ModelWinProb<BradleyTerryModel> },
+  { "bt",      true,  &PlaySeries<BradleyTerryModel, HomeIce2211<kHomeEdgeBp> >, &ModelWinProb<BradleyTerryModel> },
+  { "poisson", false, &PlaySeries<PoissonGoalsModel, NoHomeIce>,                 &ModelWinProb<PoissonGoalsModel> },
+  { "poisson", true,  &PlaySeries<PoissonGoalsModel, HomeIce2211<kHomeEdgeBp> >, &ModelWinProb<PoissonGoalsModel> },
+  { "table",   false, &PlaySeries<PoissonTableModel, NoHomeIce>,                 &ModelWinProb<PoissonTableModel> },
+  { "table",   true,  &PlaySeries<PoissonTableModel, HomeIce2211<kHomeEdgeBp> >, &ModelWinProb<PoissonTableModel> },
+};
+
+const size_t kGameModelCount = sizeof(kGameModels) / sizeof(kGameModels[0]);
+
+// Series results already simulated in the current run, indexed by both teams' record ids
+// Scenarios only give a team a new record id when they change it, so untouched series get shared
+struct SeriesCache
+{
+  explicit SeriesCache(int records) : records(records), results(records * records), filled(records * records, -1) {}
 
-  bool operator<(Team const& t) const
+  GameSplit* Find(Matchup const& matchup, int run)
   {
-    if      (conf < t.conf) return true;
-    else if (conf > t.conf) return false;
-    else {
-      return (seed < t.seed);
-    };
+    size_t slot = matchup.first.record * records + matchup.second.record;
+    return filled[slot] == run ? &results[slot] : NULL;
   }
+
+  void Store(Matchup const& matchup, int run, GameSplit const& result)
+  {
+    size_t slot = matchup.first.record * records + matchup.second.record;
+    results[slot] = result;
+    filled[slot] = run;
+  }
+
+  int records;
+  std::vector<GameSplit> results;
+  std::vector<int> filled; // run each slot was last stored in, so we never have to clear it
+};
+
+// One what-if case -- the baseline data with some team records or players changed
+struct Scenario
+{
+  std::string name;
+  Teams teams;
+  Players players;
+};
+
+typedef std::vector<Scenario> Scenarios;
+
+// How a long job runs -- checkpointing, stopping early and splitting across processes
+struct RunControl
+{
+  RunControl() : checkpoint_every(1000000), resume(false), time_budget(0), shard(0), shards(1), qmc(false), replicates(1), tilt(0), season(NULL), model(&kGameModels[0]), players(NULL) {}
+
+  std::string checkpoint_file;
+  long long checkpoint_every; // runs between checkpoints
+  bool resume;
+  double time_budget;         // seconds, 0 for no limit
+  int shard;                  // this process does slice shard of shards
+  int shards;
+  std::vector<std::string> merge_files; // partials to add up instead of simulating
+  bool qmc;                   // one scrambled Sobol point per bracket instead of pseudo-random games
+  int replicates;             // independent batches of runs, for error estimates
+  double tilt;                // importance sampling -- how far to push every game towards a coin flip (0 for off)
+  Season const* season;       // rest of the regular season to play before each bracket, NULL if the seeds are known
+  GameModelChoice const* model; // how each game gets decided
+  SeriesSetup setup;            // what the game model starts each series from
+  PlayerModel const* players;   // sample every baseline player's points in each run, NULL to skip it
+};
+
+typedef std::map<Team, std::vector<float> > TeamGamesDist;
+
+struct PlayoffResults
+{
+  TeamGamesPlayed games;    // expected games for each team
+  TeamGamesPlayed win_perc; // chance of each team winning it all
+  TeamGamesDist games_dist; // chance of each team playing 0..kMaxRunGames games
+  TeamGamesPlayed win_error; // standard error of win_perc across replicates (empty with only one)
+  TeamGamesDist seed_dist;  // chance of each team missing out (0) or getting seeds 1..kPlayoffSeeds, when the season's simulated
+  std::vector<float> player_mean; // per player in the player model, mean points over the runs (empty without one)
+  std::vector<float> player_sd;   // and their standard deviation
+  std::vector<KllSketch> player_sketches; // and their distribution over the runs (empty with importance sampling)
+};
+
+// Where a run gets its randomness from for each series it plays
+struct RunDraws
+{
+  RunDraws(unsigned run, double const* point, double tilt = 0, GameModelChoice const* model = &kGameModels[0], SeriesSetup const& setup = SeriesSetup())
+    : run(run), point(point), next(0), tilt(tilt), weight(1), model(model), setup(setup) {}
+
+  unsigned run;
+  double const* point; // one uniform per series in QMC mode, NULL to simulate game by game
+  int next;            // next coordinate of point to use
+  double tilt;         // importance sampling tilt, 0 for none
+  double weight;       // likelihood ratio of the bracket drawn so far
+  GameModelChoice const* model;
+  SeriesSetup setup;
 };
 
-typedef std::vector<Team>         Teams;
-typedef std::map<Team, float>     TeamGamesPlayed;
-typedef std::pair<Team, Team>     Matchup;
-typedef std::vector<Matchup>      Matchups;
-typedef std::pair<int, int>       GameSplit;
-typedef std::pair<Player, float>  PlayerPoints;
-typedef std::vector<PlayerPoints> PlayerPointsList;
+struct Options
+{
+  Options() : runs(100000), benchmark_qmc(false), benchmark_models(false), player_model(false), tail_points(10), serve_port(0), league_size(10)
+  {
+    // A standard pool roster
+    drafted["F"] = 9;
+    drafted["D"] = 6;
+  }
+
+  std::string bracket_file;
+  std::string scenarios_file;
+  std::string query_file; // conditional questions to answer from the indexed runs, - for the console
+  std::string schedule_file;  // games left in the regular season -- seeds get simulated when this is set
+  std::string standings_file; // every team in the league, same columns as teamdata.csv (seeds are ignored)
+  int runs;
+  bool benchmark_qmc;
+  bool benchmark_models;
+  bool player_model;     // sample player scoring rates and availability every run, rather than taking ppg as exact
+  float tail_points;     // with the player model, scores.txt also gives each player's chance of getting at least this many
+  std::string rules_file; // league scoring rules to rank players by, one league per line -- name, rule
+  std::string stats_file; // a season csv with a header row, for scoring rules to use any of its columns
+  int serve_port;        // stay up answering draft questions on this localhost port, 0 to just write the files and exit
+  int league_size;       // teams in the draft
+  std::map<std::string, int> drafted; // roster spots per team at each position, then times league_size once the options are in
+  RunControl control;
+};
 
 struct PlayerPointsListSorter
 {
@@ -80,46 +204,118 @@ Matchups GetMatchups(Teams& teams)
   return matchups;
 }
 
-GameSplit SimulateSeries(Matchup const& matchup)
+// Look up how far along a series is -- returns false if it hasn't started
+bool GetSeriesState(BracketState const& state, Matchup const& matchup, GameSplit& split)
 {
-  std::uniform_int<int> rnd_game(1, kGameTotal);
-  GameSplit result;
+  auto it = state.find(std::make_pair(matchup.first.name, matchup.second.name));
+  if (it != state.end()) {
+    split = it->second;
+    return true;
+  }
 
-  // Make sure each team has played the target number of games
-  Team const& t1 = matchup.first;
-  Team const& t2 = matchup.second;
-  //int sum1 = t1.won + t1.lost + t1.otwon;
-  //assert(sum1 == kGameTotal);
-  //int sum2 = t2.won + t2.lost + t2.otwon;
-  //assert(sum2 == kGameTotal);
+  // Could have been entered the other way around
+  it = state.find(std::make_pair(matchup.second.name, matchup.first.name));
+  if (it != state.end()) {
+    split = std::make_pair(it->second.second, it->second.first);
+    return true;
+  }
 
-  // Keep simulating until somebody wins 4 games
-  // TODO: Ignoring home ice advantage. Include it somehow?
-  while (result.first < 4 && result.second < 4) {
+  return false;
+}
 
-    // What we'll do is get a random integer between 1 and the game total
-    // We'll see if it's a win for one team and a loss for the other
-    
-    // Generate two indices to check team records
-    int g1 = rnd_game(eng);
-    int g2 = rnd_game(eng);
+bool SeriesDecided(GameSplit const& split)
+{
+  return split.first >= 4 || split.second >= 4;
+}
+
+// Cheap, stable string hash (FNV-1a) so series streams don't depend on the standard library
+unsigned HashName(std::string const& name)
+{
+  unsigned h = 2166136261u;
+  for (auto it = name.begin(); it != name.end(); ++it) {
+    h ^= static_cast<unsigned char>(*it);
+    h *= 16777619u;
+  }
+  return h;
+}
+
+// The rest of the regular season gets one stream per run, the same for every scenario
+SeriesRng SeasonEngine(unsigned run)
+{
+  unsigned long long x = (static_cast<unsigned long long>(base_seed) << 32) | run;
+  SeriesRng mix(x ^ (static_cast<unsigned long long>(HashName("season")) * 0xbf58476d1ce4e5b9ull));
+  return SeriesRng((static_cast<unsigned long long>(mix()) << 32) | mix());
+}
+
+// Every series gets its own random stream based on the run and who's playing
+// That way a scenario that doesn't touch either team draws exactly the same games as the baseline,
+// and a run doesn't depend on how many draws any other series happened to use
+SeriesRng SeriesEngine(unsigned run, Matchup const& matchup)
+{
+  unsigned long long x = (static_cast<unsigned long long>(base_seed) << 32) | run;
+  unsigned long long teams = (static_cast<unsigned long long>(HashName(matchup.first.name)) << 32) | HashName(matchup.second.name);
 
-    // Check if each team won
-    bool t1win = g1 <= t1.won;
-    bool t2win = g2 <= t2.won;
+  // Scramble the key so neighbouring runs don't start on neighbouring states
+  SeriesRng mix(x ^ (teams * 0xbf58476d1ce4e5b9ull));
+  return SeriesRng((static_cast<unsigned long long>(mix()) << 32) | mix());
+}
+
+// Every way a series can still finish from where it stands, with the chance of each
+// There are at most 8 (either team winning with the other on 0..3)
+int SeriesOutcomes(double p, GameSplit const& start, GameSplit outcomes[8], double probs[8])
+{
+  int n = 0;
+  int need1 = 4 - start.first;
+  int need2 = 4 - start.second;
+
+  // The winner takes the last game, so the other games can fall in any order
+  for (int losses = 0; losses < need2; ++losses) {
+    double ways = 1;
+    for (int k = 1; k <= losses; ++k) ways = ways * (need1 - 1 + k) / k;
+    outcomes[n] = std::make_pair(4, start.second + losses);
+    probs[n++] = ways * std::pow(p, need1) * std::pow(1 - p, losses);
+  }
+  for (int losses = 0; losses < need1; ++losses) {
+    double ways = 1;
+    for (int k = 1; k <= losses; ++k) ways = ways * (need2 - 1 + k) / k;
+    outcomes[n] = std::make_pair(start.first + losses, 4);
+    probs[n++] = ways * std::pow(1 - p, need2) * std::pow(p, losses);
+  }
+
+  return n;
+}
 
-    // If this result doesn't make sense (both won or both lost) then discard it and start again
-    if (t1win == t2win) continue;
+// Same distribution as playing the series game by game on neutral ice, but the whole series comes from one uniform (inverse CDF)
+GameSplit SampleSeries(double p, GameSplit const& start, double u)
+{
+  GameSplit outcomes[8];
+  double probs[8];
+  int n = SeriesOutcomes(p, start, outcomes, probs);
 
-    // Mark down the results
-    result.first  += t1win;
-    result.second += t2win;
+  for (int k = 0; k < n - 1; ++k) {
+    if (u < probs[k]) return outcomes[k];
+    u -= probs[k];
   }
+  return outcomes[n - 1];
+}
+
+// Game odds pushed towards a coin flip, so underdogs go on runs far more often than they really would
+// Stays away from 0 and 1 so every outcome is still possible and the weights stay finite
+double TiltedWinProb(double p, double tilt)
+{
+  return std::min(0.99, std::max(0.01, p + tilt * (0.5 - p)));
+}
 
-  return result;
+// How much likelier a series result is under the real odds p than the tilted odds q
+// The number of orderings is the same either way, so only the games won from the start count
+double SeriesLikelihoodRatio(double p, double q, GameSplit const& start, GameSplit const& result)
+{
+  int won1 = result.first - start.first;
+  int won2 = result.second - start.second;
+  return std::pow(p / q, won1) * std::pow((1 - p) / (1 - q), won2);
 }
 
-void RunRound(Teams const& teams, TeamGamesPlayed& games_played, Teams& teams_remaining)
+void RunRound(Teams const& teams, BracketState const& state, RunDraws& draws, SeriesCache* cache, TeamCounts& games_played, Teams& teams_remaining)
 {
   // Sort by conference, then by seed
   Teams teams_copy = teams;
@@ -132,7 +328,31 @@ void RunRound(Teams const& teams, TeamGamesPlayed& games_played, Teams& teams_re
   
   // For each matchup, simulate a series
   for (auto it = matchups.begin(); it != matchups.end(); ++it) {
-    GameSplit gs = SimulateSeries(*it);
+    GameSplit gs;
+    GetSeriesState(state, *it, gs);
+    if (!SeriesDecided(gs)) {
+      // Another scenario may have already played this exact series in this run
+      GameSplit const* cached = cache && draws.tilt == 0 ? cache->Find(*it, draws.run) : NULL;
+      if (draws.tilt > 0) {
+        // Play it with the odds tilted towards the underdog, then weight the run by how much likelier that made it
+        double p = draws.model->win_prob(it->first, it->second, draws.setup);
+        double q = TiltedWinProb(p, draws.tilt);
+        double u = draws.point ? draws.point[draws.next++] : SeriesEngine(draws.run, *it).Uniform();
+        GameSplit start = gs;
+        gs = SampleSeries(q, start, u);
+        draws.weight *= SeriesLikelihoodRatio(p, q, start, gs);
+      } else if (draws.point) {
+        gs = SampleSeries(draws.model->win_prob(it->first, it->second, draws.setup), gs, draws.point[draws.next++]);
+      } else if (cached) {
+        gs = *cached;
+      } else {
+        SeriesRng eng = SeriesEngine(draws.run, *it);
+        gs = draws.model->simulate(*it, gs, draws.setup, eng);
+        if (cache && draws.tilt == 0) {
+          cache->Store(*it, draws.run, gs);
+        }
+      }
+    }
     
     // We've got the game results, so we'll eliminate the losing team
     games_played[it->first]  += gs.first;
@@ -150,58 +370,583 @@ void RunRound(Teams const& teams, TeamGamesPlayed& games_played, Teams& teams_re
   teams_remaining = winners;
 }
 
-TeamGamesPlayed RunPlayoffs(Teams const& teams, int runs, TeamGamesPlayed& win_perc)
+// Play forward through any rounds where every series is already decided
+// These are the same in every run, so we only do them once
+// Returns the teams still alive and the games they've played so far
+Teams AdvanceDecidedRounds(Teams const& teams, BracketState const& state, TeamGamesPlayed& games_played)
 {
-  TeamGamesPlayed games_played;
+  Teams teams_in = teams;
 
-  // Run it a bunch of times
-  for (auto i = 0; i < runs; ++i) {
-    
-    static int perc = -1;
-    int new_perc = i * 100 / runs;
-    if (new_perc != perc) {
-      std::cout << "Simulation " << new_perc << "% done." << std::endl;
-        perc = new_perc;
+  while (teams_in.size() > 1) {
+    Matchups matchups = GetMatchups(teams_in);
+
+    // Stop as soon as there's a series left to play in this round
+    Teams winners;
+    for (auto it = matchups.begin(); it != matchups.end(); ++it) {
+      GameSplit gs;
+      if (!GetSeriesState(state, *it, gs) || !SeriesDecided(gs)) {
+        return teams_in;
+      }
+      winners.push_back(gs.first > gs.second ? it->first : it->second);
+    }
+
+    // Whole round is done, so count the games the same way RunRound does and move on
+    for (auto it = matchups.begin(); it != matchups.end(); ++it) {
+      GameSplit gs;
+      GetSeriesState(state, *it, gs);
+      games_played[it->first]  += gs.first;
+      games_played[it->second] += gs.second;
+    }
+    teams_in = winners;
+  }
+
+  return teams_in;
+}
+
+// One simulated playoffs from wherever the bracket stands -- returns the champion
+Team SimulateBracket(Teams const& teams_start, BracketState const& state, RunDraws& draws, SeriesCache* cache, TeamCounts& games_played)
+{
+  Teams teams_in = teams_start;
+  Teams teams_out = teams_start;
+
+  // Go through each round -- we'll eliminate teams until there's one winner
+  while (teams_in.size() > 1) {
+    RunRound(teams_in, state, draws, cache, games_played, teams_out);
+    teams_in = teams_out;
+  }
+
+  return teams_out.front();
+}
+
+// Exact chance of each team winning it all, by going through every way the series can fall
+// Only 2^15 brackets from the start of the playoffs, fewer once some series are done
+void ExactChampionOdds(Teams const& teams, BracketState const& state, WinProbFunction win_prob, SeriesSetup const& setup, double prob, TeamGamesPlayed& odds)
+{
+  if (teams.size() == 1) {
+    odds[teams.front()] += static_cast<float>(prob);
+    return;
+  }
+
+  Teams teams_copy = teams;
+  Matchups matchups = GetMatchups(teams_copy);
+
+  // Chance the first team takes each series
+  std::vector<double> first_wins(matchups.size());
+  for (size_t m = 0; m < matchups.size(); ++m) {
+    GameSplit gs;
+    GetSeriesState(state, matchups[m], gs);
+    if (SeriesDecided(gs)) {
+      first_wins[m] = gs.first > gs.second ? 1 : 0;
+      continue;
     }
+    GameSplit outcomes[8];
+    double probs[8];
+    int n = SeriesOutcomes(win_prob(matchups[m].first, matchups[m].second, setup), gs, outcomes, probs);
+    first_wins[m] = 0;
+    for (int k = 0; k < n; ++k) {
+      if (outcomes[k].first == 4) first_wins[m] += probs[k];
+    }
+  }
 
-    Teams teams_in = teams;
-    Teams teams_out;
+  // Every combination of winners for this round
+  for (unsigned mask = 0; mask < (1u << matchups.size()); ++mask) {
+    double p = prob;
+    Teams winners;
+    for (size_t m = 0; m < matchups.size(); ++m) {
+      bool first = ((mask >> m) & 1) == 0;
+      p *= first ? first_wins[m] : 1 - first_wins[m];
+      winners.push_back(first ? matchups[m].first : matchups[m].second);
+    }
+    if (p > 0) {
+      ExactChampionOdds(winners, state, win_prob, setup, p, odds);
+    }
+  }
+}
 
-    // Go through each round -- we'll eliminate teams until there's one winner
-    while (teams_in.size() > 1) {
-      RunRound(teams_in, games_played, teams_out);
-      teams_in = teams_out;
+// Random digital shift for each replicate and Sobol dimension -- turns the fixed Sobol points into
+// independent randomized copies, so replicates give an honest error estimate
+std::vector<unsigned> SobolShifts(int replicates)
+{
+  std::vector<unsigned> shifts(replicates * Sobol::kDims);
+  for (int r = 0; r < replicates; ++r) {
+    SeriesRng rng((static_cast<unsigned long long>(base_seed) << 32) ^ (0x51ed270b27ull * (r + 1)));
+    for (int d = 0; d < Sobol::kDims; ++d) {
+      shifts[r * Sobol::kDims + d] = rng();
     }
+  }
+  return shifts;
+}
 
-    // We have found a winner!
-    win_perc[teams_out.front()] += 1;
+// Fill in the QMC point for a run -- runs are split evenly into replicates, each walking its own shifted Sobol sequence
+void SobolPoint(Sobol const& sobol, std::vector<unsigned> const& shifts, long long run, long long runs, int replicates, double point[Sobol::kDims])
+{
+  long long r = run * replicates / runs;
+  long long index = run - (r * runs + replicates - 1) / replicates;
+  for (int d = 0; d < Sobol::kDims; ++d) {
+    unsigned x = sobol.Point(static_cast<unsigned>(index), d) ^ shifts[r * Sobol::kDims + d];
+    point[d] = (x + 0.5) / 4294967296.0;
   }
+}
 
-  // Normalize by the number of runs we've done...
-  for (auto it = games_played.begin(); it != games_played.end(); ++it) {
-    it->second /= runs;
+// Compare plain Monte Carlo against QMC at the same run counts, using the exact champion odds as the answer
+void BenchmarkQmc(Teams const& teams, BracketState const& state, GameModelChoice const* chosen, SeriesSetup const& setup)
+{
+  TeamGamesPlayed decided;
+  Teams teams_start = AdvanceDecidedRounds(teams, state, decided);
+
+  // The exact odds are on neutral ice, so the runs checked against them leave home ice out too
+  GameModelChoice const* model = chosen;
+  for (size_t m = 0; m < kGameModelCount; ++m) {
+    if (!strcmp(kGameModels[m].name, chosen->name) && !kGameModels[m].home_ice) model = &kGameModels[m];
   }
-  for (auto it = win_perc.begin(); it != win_perc.end(); ++it) {
-    it->second /= runs;
+
+  TeamGamesPlayed exact;
+  ExactChampionOdds(teams_start, state, model->win_prob, setup, 1, exact);
+
+  Sobol sobol;
+  const int kTrials = 16;
+  unsigned saved_seed = base_seed;
+
+  std::cout << std::setw(8) << "runs" << std::setw(14) << "MC rmse" << std::setw(14) << "QMC rmse" << std::setw(10) << "ratio" << std::endl;
+  for (long long runs = 1024; runs <= 65536; runs *= 4) {
+    double sq_err[2] = { 0, 0 };
+
+    for (int trial = 0; trial < kTrials; ++trial) {
+      base_seed = saved_seed + trial;
+      std::vector<unsigned> shifts = SobolShifts(1);
+
+      for (int qmc = 0; qmc < 2; ++qmc) {
+        TeamGamesPlayed wins;
+        TeamCounts games;
+        for (long long i = 0; i < runs; ++i) {
+          double point[Sobol::kDims];
+          if (qmc) SobolPoint(sobol, shifts, i, runs, 1, point);
+          RunDraws draws(static_cast<unsigned>(i), qmc ? point : NULL, 0, model, setup);
+          wins[SimulateBracket(teams_start, state, draws, NULL, games)] += 1;
+        }
+        for (auto it = exact.begin(); it != exact.end(); ++it) {
+          double err = wins[it->first] / runs - it->second;
+          sq_err[qmc] += err * err;
+        }
+      }
+    }
+
+    double mc = std::sqrt(sq_err[0] / (kTrials * exact.size()));
+    double qmc = std::sqrt(sq_err[1] / (kTrials * exact.size()));
+    std::cout << std::setw(8) << runs << std::setw(14) << mc << std::setw(14) << qmc << std::setw(10) << (qmc > 0 ? mc / qmc : 0) << std::endl;
+  }
+
+  base_seed = saved_seed;
+}
+
+// Runs/sec for every game model, so accuracy can be weighed against speed
+// Also shows the favourite's title odds under each one, to see how much the choice matters
+void BenchmarkModels(Teams const& teams, BracketState const& state, SeriesSetup const& setup)
+{
+  TeamGamesPlayed decided;
+  Teams teams_start = AdvanceDecidedRounds(teams, state, decided);
+  const long long kRuns = 200000;
+
+  std::cout << std::setw(10) << "model" << std::setw(12) << "home ice" << std::setw(14) << "runs/sec" << "   favourite" << std::endl;
+  for (size_t m = 0; m < kGameModelCount; ++m) {
+    TeamCounts games;
+    TeamGamesPlayed wins;
+    std::chrono::steady_clock::time_point started = std::chrono::steady_clock::now();
+    for (long long i = 0; i < kRuns; ++i) {
+      RunDraws draws(static_cast<unsigned>(i), NULL, 0, &kGameModels[m], setup);
+      wins[SimulateBracket(teams_start, state, draws, NULL, games)] += 1;
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - started;
+
+    TeamGamesPlayed::const_iterator best = wins.begin();
+    for (auto it = wins.begin(); it != wins.end(); ++it) {
+      if (it->second > best->second) best = it;
+    }
+    std::cout << std::setw(10) << kGameModels[m].name << std::setw(12) << (kGameModels[m].home_ice ? "2-2-1-1-1" : "none")
+              << std::setw(14) << static_cast<long long>(kRuns / std::max(elapsed.count(), 1e-9))
+              << "   " << best->first.name << " " << std::fixed << std::setprecision(2) << best->second * 100 / kRuns << "%" << std::endl;
+  }
+}
+
+// Fingerprint of everything a run depends on besides the seed, so a checkpoint can't be resumed against different data
+unsigned HashInputs(std::vector<Teams> const& team_sets, BracketState const& state, std::string const& mode)
+{
+  std::ostringstream inputs;
+  inputs << mode << '|';
+  for (auto s = team_sets.begin(); s != team_sets.end(); ++s) {
+    for (auto it = s->begin(); it != s->end(); ++it) {
+      inputs << it->name << it->conf << it->seed << ',' << it->won << ',' << it->lost << ',' << it->otlost << ',' << it->gf << ',' << it->ga << ';';
+    }
+    inputs << '|';
+  }
+  for (auto it = state.begin(); it != state.end(); ++it) {
+    inputs << it->first.first << it->first.second << it->second.first << ',' << it->second.second << ';';
+  }
+  return HashName(inputs.str());
+}
+
+// Run every set of teams through the same simulated playoffs
+// Each run uses the same random streams for every set (common random numbers), so differences
+// between the sets come from the changes themselves rather than sampling noise
+// If index is given, every run of the first set gets kept in it for conditional questions afterwards
+std::vector<PlayoffResults> RunPlayoffs(std::vector<Teams> const& team_sets, BracketState const& state, int runs, RunControl const& control, RunIndex* index = NULL)
+{
+  size_t sets = team_sets.size();
+  PlayoffTallies tallies(sets);
+
+  // Skip any rounds that are already in the books -- we add their games back at the end
+  std::vector<TeamGamesPlayed> games_decided(sets);
+  std::vector<Teams> teams_start(sets);
+  for (size_t s = 0; s < sets; ++s) {
+    // With the season still going, the bracket isn't known until each run has played it out
+    teams_start[s] = control.season ? team_sets[s] : AdvanceDecidedRounds(team_sets[s], state, games_decided[s]);
+
+    // Make sure every team shows up in the output, even if they're already out
+    for (auto it = team_sets[s].begin(); it != team_sets[s].end(); ++it) {
+      tallies[s].games[*it] = 0;
+      tallies[s].wins[*it] = 0;
+      tallies[s].wins_sq[*it] = 0;
+      tallies[s].games_hist[*it].assign(kMaxRunGames + 1, 0);
+      tallies[s].seed_hist[*it].assign(kPlayoffSeeds + 1, 0);
+    }
+    tallies[s].replicate_wins.assign(control.replicates, tallies[s].wins);
+  }
+  // Player points are only sampled for the baseline
+  if (control.players) {
+    tallies[0].player_points.assign(control.players->size(), 0);
+    tallies[0].player_points_sq.assign(control.players->size(), 0);
+
+    // Quantiles need every run to count the same, so there's no sketch to keep with importance weights
+    if (control.tilt == 0) {
+      tallies[0].player_sketches.assign(control.players->size(), KllSketch());
+    }
+  }
+
+  // Only worth remembering series results if there's somebody to share them with
+  int records = 0;
+  for (size_t s = 0; s < sets; ++s) {
+    for (auto it = team_sets[s].begin(); it != team_sets[s].end(); ++it) {
+      records = std::max(records, it->record + 1);
+    }
+  }
+  // QMC draws by position in the bracket rather than by matchup, so it can't share series
+  SeriesCache cache(sets > 1 ? records : 0);
+  SeriesCache* shared = sets > 1 && !control.qmc ? &cache : NULL;
+
+  // Sets that didn't change any team (player-only scenarios) get the whole bracket for free
+  std::vector<size_t> same_as(sets);
+  for (size_t s = 0; s < sets; ++s) {
+    same_as[s] = s;
+    for (size_t o = 0; o < s && same_as[s] == s; ++o) {
+      bool same = team_sets[o].size() == team_sets[s].size();
+      for (size_t k = 0; same && k < team_sets[s].size(); ++k) {
+        same = team_sets[o][k].record == team_sets[s][k].record;
+      }
+      if (same) same_as[s] = o;
+    }
+  }
+
+  CheckpointKey key;
+  key.seed = base_seed;
+  std::ostringstream mode;
+  mode << (control.qmc ? "qmc" : "mc") << control.tilt << control.model->name << control.model->home_ice;
+  if (control.season) {
+    for (auto it = control.season->games.begin(); it != control.season->games.end(); ++it) {
+      mode << ',' << static_cast<int>(it->home) << '@' << static_cast<int>(it->away);
+    }
+  }
+  key.data_hash = HashInputs(team_sets, state, mode.str());
+  key.runs = runs;
+
+  // A shard only does its own slice of the runs -- since every run has its own random streams,
+  // the slices add back up to exactly what one process would have done
+  long long first_run = static_cast<long long>(runs) * control.shard / control.shards;
+  long long last_run = static_cast<long long>(runs) * (control.shard + 1) / control.shards;
+  long long done = 0;
+
+  if (!control.merge_files.empty()) {
+    // Nothing to simulate -- just add up what the shards did
+    done = MergeCheckpoints(control.merge_files, key, tallies);
+    if (done <= 0) {
+      std::cout << "Merge failed" << std::endl;
+      return std::vector<PlayoffResults>();
+    }
+  } else {
+    // Pick up a stopped job if we've been asked to
+    long long next_run = first_run;
+    bool checkpointing = !control.checkpoint_file.empty();
+    if (checkpointing && control.resume) {
+      PlayoffTallies saved = tallies;
+      long long saved_first = 0;
+      if (ReadCheckpoint(control.checkpoint_file, key, saved_first, next_run, saved) && saved_first == first_run) {
+        tallies = saved;
+        std::cout << "Resuming at run " << next_run << " of " << last_run << std::endl;
+      } else {
+        next_run = first_run;
+        std::cout << "No usable checkpoint in " << control.checkpoint_file << ", starting over" << std::endl;
+      }
+    }
+
+    std::chrono::steady_clock::time_point started = std::chrono::steady_clock::now();
+
+    Sobol sobol;
+    std::vector<unsigned> shifts = SobolShifts(control.replicates);
+
+    // Games for each team in the current run, so we can build up the histograms
+    std::vector<TeamCounts> run_games(sets);
+    for (size_t s = 0; s < sets; ++s) {
+      run_games[s] = tallies[s].games;
+    }
+
+    // Seeds change from run to run when the season's simulated, so results get matched back
+    // to the teams the tallies are keyed on through their record ids
+    std::vector<std::vector<Team> > key_of_record(sets, std::vector<Team>(records));
+    for (size_t s = 0; s < sets; ++s) {
+      for (auto it = team_sets[s].begin(); it != team_sets[s].end(); ++it) {
+        key_of_record[s][it->record] = *it;
+      }
+    }
+    TeamCounts season_games;
+
+    // Each run's games for every team in column order (plus the zero column), and the points they make
+    std::vector<float> team_games(tallies[0].games.size() + 1, 0.f);
+    std::vector<float> player_points(control.players ? control.players->size() : 0);
+
+    // The index only sees runs simulated here, not ones that came out of a checkpoint
+    if (index) {
+      Teams columns;
+      for (auto it = tallies[0].games.begin(); it != tallies[0].games.end(); ++it) {
+        columns.push_back(it->first);
+      }
+      index->Reset(columns, games_decided[0]);
+      index->games.reserve(static_cast<size_t>(last_run - next_run) * columns.size());
+      if (next_run != first_run) {
+        std::cout << "Only runs from " << next_run << " on will be indexed" << std::endl;
+      }
+    }
+
+    // Run it a bunch of times
+    long long i = next_run;
+    for (; i < last_run; ++i) {
+      
+      static int perc = -1;
+      int new_perc = static_cast<int>((i - first_run) * 100 / std::max(last_run - first_run, 1LL));
+      if (new_perc != perc) {
+        std::cout << "Simulation " << new_perc << "% done." << std::endl;
+          perc = new_perc;
+      }
+
+      // Only look at the clock every so often, it's not free
+      if (control.time_budget > 0 && (i & 1023) == 0) {
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - started;
+        if (elapsed.count() >= control.time_budget) break;
+      }
+
+      // QMC runs all share the one point -- it's the same bracket position in every scenario
+      size_t replicate = static_cast<size_t>(i * control.replicates / runs);
+      double point[Sobol::kDims];
+      if (control.qmc) {
+        SobolPoint(sobol, shifts, i, runs, control.replicates, point);
+      }
+
+      for (size_t s = 0; s < sets; ++s) {
+        if (same_as[s] != s) continue;
+
+        for (auto it = run_games[s].begin(); it != run_games[s].end(); ++it) {
+          it->second = 0;
+        }
+
+        RunDraws draws(static_cast<unsigned>(i), control.qmc ? point : NULL, control.tilt, control.model, control.setup);
+        Team champion;
+        if (control.season) {
+          SeriesRng eng = SeasonEngine(static_cast<unsigned>(i));
+          Teams bracket = SimulateSeason(*control.season, team_sets[s], eng);
+          season_games.clear();
+          champion = key_of_record[s][SimulateBracket(bracket, state, draws, shared, season_games).record];
+          for (auto it = season_games.begin(); it != season_games.end(); ++it) {
+            run_games[s][key_of_record[s][it->first.record]] = it->second;
+          }
+          for (auto it = bracket.begin(); it != bracket.end(); ++it) {
+            tallies[s].seed_hist[key_of_record[s][it->record]][it->seed] += draws.weight;
+          }
+        } else {
+          champion = SimulateBracket(teams_start[s], state, draws, shared, run_games[s]);
+        }
+        double weight = draws.weight;
+
+        // We have found a winner!
+        tallies[s].wins[champion] += weight;
+        tallies[s].wins_sq[champion] += weight * weight;
+        tallies[s].replicate_wins[replicate][champion] += weight;
+
+        TeamCounts::iterator total = tallies[s].games.begin();
+        TeamHistograms::iterator hist = tallies[s].games_hist.begin();
+        for (auto it = run_games[s].begin(); it != run_games[s].end(); ++it, ++total, ++hist) {
+          total->second += weight * it->second;
+          hist->second[static_cast<size_t>(it->second)] += weight;
+        }
+
+        if (index && s == 0) {
+          index->AddRun(run_games[s], weight);
+        }
+
+        if (!player_points.empty() && s == 0) {
+          size_t t = 0;
+          for (auto it = run_games[s].begin(); it != run_games[s].end(); ++it, ++t) {
+            team_games[t] = static_cast<float>(it->second) + games_decided[s][it->first];
+          }
+          SamplePlayerPoints(*control.players, &team_games[0], base_seed, static_cast<unsigned>(i), &player_points[0]);
+          for (size_t p = 0; p < control.players->size(); ++p) {
+            tallies[s].player_points[p] += weight * player_points[p];
+            tallies[s].player_points_sq[p] += weight * player_points[p] * player_points[p];
+          }
+          // Players whose team isn't in it always get 0, which doesn't need a sketch to remember
+          for (size_t p = 0; p < tallies[s].player_sketches.size(); ++p) {
+            if (static_cast<size_t>(control.players->team[p]) == control.players->teams) continue;
+            tallies[s].player_sketches[p].Add(player_points[p]);
+          }
+        }
+      }
+
+      if (checkpointing && (i + 1) % control.checkpoint_every == 0) {
+        WriteCheckpoint(control.checkpoint_file, key, first_run, i + 1, tallies);
+      }
+    }
+
+    // Always leave a checkpoint behind when we stop, so a time-limited job can carry on later
+    // For a shard this is also the partial result that gets merged
+    if (checkpointing) {
+      WriteCheckpoint(control.checkpoint_file, key, first_run, i, tallies);
+    }
+
+    if (control.time_budget > 0) {
+      std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - started;
+      long long ran = i - next_run;
+      std::cout << "Fit " << ran << " runs in " << elapsed.count() << " seconds (" << static_cast<long long>(ran / std::max(elapsed.count(), 1e-9)) << " runs/sec)" << std::endl;
+    }
+
+    done = i - first_run;
+  }
+
+  // Normalize by the number of runs we've done...
+  std::vector<PlayoffResults> results(sets);
+  for (size_t s = 0; s < sets; ++s) {
+    PlayoffTally const& tally = tallies[same_as[s]];
+    PlayoffResults& result = results[s];
+    for (auto it = tally.games.begin(); it != tally.games.end(); ++it) {
+      result.games[it->first] = done ? static_cast<float>(it->second / done) : 0.f;
+      result.games[it->first] += games_decided[s][it->first];
+    }
+    for (auto it = tally.wins.begin(); it != tally.wins.end(); ++it) {
+      result.win_perc[it->first] = done ? static_cast<float>(it->second / done) : 0.f;
+    }
+
+    // With importance sampling each run is already an independent weighted sample, so the variance comes straight from the weights
+    if (control.tilt > 0 && done > 1) {
+      for (auto it = tally.wins.begin(); it != tally.wins.end(); ++it) {
+        double mean = it->second / done;
+        double var = std::max(0.0, (tally.wins_sq.find(it->first)->second / done - mean * mean) * done / (done - 1));
+        result.win_error[it->first] = static_cast<float>(std::sqrt(var / done));
+      }
+    }
+
+    // Spread of the replicate estimates around their mean gives the standard error
+    // Only whole replicates count, so this wants the full job (or a merge of every shard)
+    if (control.replicates > 1 && done == runs && control.tilt == 0) {
+      for (auto it = tally.wins.begin(); it != tally.wins.end(); ++it) {
+        double sum = 0;
+        double sum_sq = 0;
+        for (int r = 0; r < control.replicates; ++r) {
+          long long first = (static_cast<long long>(r) * runs + control.replicates - 1) / control.replicates;
+          long long next = (static_cast<long long>(r + 1) * runs + control.replicates - 1) / control.replicates;
+          double est = next > first ? tally.replicate_wins[r].find(it->first)->second / (next - first) : 0;
+          sum += est;
+          sum_sq += est * est;
+        }
+        double mean = sum / control.replicates;
+        double var = std::max(0.0, (sum_sq - control.replicates * mean * mean) / (control.replicates - 1));
+        result.win_error[it->first] = static_cast<float>(std::sqrt(var / control.replicates));
+      }
+    }
+
+    for (size_t p = 0; p < tally.player_points.size() && done > 0; ++p) {
+      double mean = tally.player_points[p] / done;
+      result.player_mean.push_back(static_cast<float>(mean));
+      result.player_sd.push_back(static_cast<float>(std::sqrt(std::max(0.0, tally.player_points_sq[p] / done - mean * mean))));
+    }
+    result.player_sketches = tally.player_sketches;
+
+    // Every run crowns exactly one champion, so the wins add up to all the runs and whatever didn't get a seed missed out
+    if (control.season) {
+      double total = 0;
+      for (auto it = tally.wins.begin(); it != tally.wins.end(); ++it) {
+        total += it->second;
+      }
+      for (auto it = tally.seed_hist.begin(); it != tally.seed_hist.end(); ++it) {
+        std::vector<float>& dist = result.seed_dist[it->first];
+        dist.assign(kPlayoffSeeds + 1, 0.f);
+        double seeded = 0;
+        for (int k = 1; k <= kPlayoffSeeds; ++k) {
+          dist[k] = done ? static_cast<float>(it->second[k] / done) : 0.f;
+          seeded += it->second[k];
+        }
+        dist[0] = done ? static_cast<float>(std::max(0.0, total - seeded) / done) : 0.f;
+      }
+    }
+
+    // Games from decided rounds are the same every run, so they just shift the distribution along
+    for (auto it = tally.games_hist.begin(); it != tally.games_hist.end(); ++it) {
+      std::vector<float>& dist = result.games_dist[it->first];
+      dist.assign(kMaxRunGames + 1, 0.f);
+      int offset = static_cast<int>(games_decided[s][it->first]);
+      for (int k = 0; k + offset <= kMaxRunGames; ++k) {
+        dist[k + offset] = done ? static_cast<float>(it->second[k] / done) : 0.f;
+      }
+    }
   }
 
   std::cout << "Simulation done." << std::endl;
 
-  return games_played;
+  return results;
 }
 
+// Where each team and player field comes from. The files we ship don't have a header row, so
+// fields go by position in them, but one that does can have its columns in any order.
+strtk_bind_begin(Team)
+  strtk_bind_column_at(name, "team|name", 0)
+  strtk_bind_column_at(conf, "conf|conference", 1)
+  strtk_bind_column_at(seed, "seed", 2)
+  strtk_bind_column_at(won, "won|wins", 3)
+  strtk_bind_column_at(lost, "lost|losses", 4)
+  strtk_bind_column_at(otlost, "otl|otlost", 5)
+  // Goals for and against are optional, after games played
+  strtk_bind_optional_at(gf, "gf|goals for", 7)
+  strtk_bind_optional_at(ga, "ga|goals against", 8)
+strtk_bind_end()
+
+strtk_bind_begin(Player)
+  strtk_bind_column_at(name, "name|player", 0)
+  strtk_bind_column_at(team, "team|tm", 1)
+  strtk_bind_column_at(gp, "gp|games", 2)
+  strtk_bind_column_at(pts, "pts|points", 3)
+strtk_bind_end()
+
 Teams GetTeams(strtk::token_grid const& grid)
 {
   Teams teams;
-  for (size_t i = 0; i < grid.row_count(); ++i) {
-    strtk::token_grid::row_type r = grid.row(i);
-    Team t;
-    t.name = r.get<std::string>(0);
-    t.conf = r.get<char>(1);
-    t.seed = r.get<int>(2);
-    t.won = r.get<int>(3);
-    t.lost = r.get<int>(4);
-    t.otlost = r.get<int>(5);
+  strtk::grid_binding<Team> binding;
+  std::string error;
+  if (!binding.resolve(grid, error)) {
+    std::cout << "Team columns: " << error << std::endl;
+    return teams;
+  }
+  for (size_t i = binding.first_row(); i < grid.row_count(); ++i) {
+    Team t = Team();
+    if (!binding.parse(grid.row(i), t)) {
+      std::cout << "Skipping bad team on row " << i << std::endl;
+      continue;
+    }
+    t.record = static_cast<int>(teams.size());
     teams.push_back(t);
   }
   return teams;
@@ -210,19 +955,288 @@ Teams GetTeams(strtk::token_grid const& grid)
 Players GetPlayers(strtk::token_grid const& grid, std::string const& pos)
 {
   Players players;
-  for (size_t i = 0; i < grid.row_count(); ++i) {
-    strtk::token_grid::row_type r = grid.row(i);
+  strtk::grid_binding<Player> binding;
+  std::string error;
+  if (!binding.resolve(grid, error)) {
+    std::cout << "Player columns: " << error << std::endl;
+    return players;
+  }
+  for (size_t i = binding.first_row(); i < grid.row_count(); ++i) {
     Player p;
-    p.name = r.get<std::string>(0);
-    p.team = r.get<std::string>(1);
-    p.gp = r.get<int>(2);
-    p.pts = r.get<int>(3);
+    if (!binding.parse(grid.row(i), p)) {
+      std::cout << "Skipping bad player on row " << i << std::endl;
+      continue;
+    }
     p.pos = pos; // copy inputted position
     players.push_back(p);
   }
   return players;
 }
 
+// A row the way it was written, for saying which one was wrong
+std::string RowText(strtk::token_grid::row_type const& r)
+{
+  std::string text;
+  for (size_t c = 0; c < r.size(); ++c) {
+    if (c) text += ',';
+    text += r.get<std::string>(c);
+  }
+  return text;
+}
+
+// One series per line -- team, team, wins, wins
+// Returns false if a row isn't a series between two teams we know about, with each side on 0 to 4 wins
+bool GetBracketState(strtk::token_grid const& grid, Teams const& teams, BracketState& state)
+{
+  state.clear();
+  for (size_t i = 0; i < grid.row_count(); ++i) {
+    strtk::token_grid::row_type r = grid.row(i);
+    std::string names[2];
+    GameSplit split;
+    if (r.size() < 4 || !r.parse(names[0], names[1], split.first, split.second)) {
+      std::cout << "Bad bracket row " << i << ": " << RowText(r) << std::endl;
+      return false;
+    }
+    for (int k = 0; k < 2; ++k) {
+      bool known = false;
+      for (auto it = teams.begin(); it != teams.end(); ++it) {
+        if (it->name == names[k]) known = true;
+      }
+      if (!known) {
+        std::cout << "Unknown team " << names[k] << " on bracket row " << i << ": " << RowText(r) << std::endl;
+        return false;
+      }
+    }
+    if (names[0] == names[1] || split.first < 0 || split.first > 4 || split.second < 0 || split.second > 4 || (split.first == 4 && split.second == 4)) {
+      std::cout << "Impossible series on bracket row " << i << ": " << RowText(r) << std::endl;
+      return false;
+    }
+    state[std::make_pair(names[0], names[1])] = split;
+  }
+  return true;
+}
+
+// One game per line -- home team, away team
+// Returns false if a team isn't one we know about
+bool GetSchedule(strtk::token_grid const& grid, Season& season)
+{
+  season.games.clear();
+  for (size_t i = 0; i < grid.row_count(); ++i) {
+    strtk::token_grid::row_type r = grid.row(i);
+    std::string names[2] = { r.get<std::string>(0), r.get<std::string>(1) };
+    int slots[2] = { -1, -1 };
+    for (int k = 0; k < 2; ++k) {
+      for (size_t slot = 0; slot < season.teams.size(); ++slot) {
+        if (season.teams[slot].name == names[k]) slots[k] = static_cast<int>(slot);
+      }
+      if (slots[k] < 0) {
+        std::cout << "Unknown team " << names[k] << " on schedule row " << i << std::endl;
+        return false;
+      }
+    }
+    ScheduledGame game;
+    game.home = static_cast<unsigned char>(slots[0]);
+    game.away = static_cast<unsigned char>(slots[1]);
+    season.games.push_back(game);
+  }
+  return true;
+}
+
+Options ParseOptions(int argc, char* argv[])
+{
+  Options options;
+  std::string model = "record";
+  bool home_ice = false;
+  for (int i = 1; i < argc; ++i) {
+    if (!strcmp(argv[i], "--bracket") && i + 1 < argc) {
+      options.bracket_file = argv[++i];
+    } else if (!strcmp(argv[i], "--scenarios") && i + 1 < argc) {
+      options.scenarios_file = argv[++i];
+    } else if (!strcmp(argv[i], "--seed") && i + 1 < argc) {
+      base_seed = strtoul(argv[++i], NULL, 10);
+    } else if (!strcmp(argv[i], "--runs") && i + 1 < argc) {
+      options.runs = atoi(argv[++i]);
+    } else if (!strcmp(argv[i], "--checkpoint") && i + 1 < argc) {
+      options.control.checkpoint_file = argv[++i];
+    } else if (!strcmp(argv[i], "--checkpoint-every") && i + 1 < argc) {
+      options.control.checkpoint_every = std::max(1LL, atoll(argv[++i]));
+    } else if (!strcmp(argv[i], "--resume")) {
+      options.control.resume = true;
+    } else if (!strcmp(argv[i], "--time-budget") && i + 1 < argc) {
+      options.control.time_budget = atof(argv[++i]);
+    } else if (!strcmp(argv[i], "--shard") && i + 1 < argc) {
+      // i/n -- this is slice i (from 0) of n
+      int shard = 0;
+      int shards = 0;
+      if (sscanf(argv[++i], "%d/%d", &shard, &shards) == 2 && shards > 0 && shard >= 0 && shard < shards) {
+        options.control.shard = shard;
+        options.control.shards = shards;
+      } else {
+        std::cout << "Bad shard " << argv[i] << ", expected i/n" << std::endl;
+      }
+    } else if (!strcmp(argv[i], "--qmc")) {
+      options.control.qmc = true;
+    } else if (!strcmp(argv[i], "--replicates") && i + 1 < argc) {
+      options.control.replicates = std::max(1, atoi(argv[++i]));
+    } else if (!strcmp(argv[i], "--importance") && i + 1 < argc) {
+      options.control.tilt = std::max(0.0, atof(argv[++i]));
+    } else if (!strcmp(argv[i], "--query") && i + 1 < argc) {
+      options.query_file = argv[++i];
+    } else if (!strcmp(argv[i], "--schedule") && i + 1 < argc) {
+      options.schedule_file = argv[++i];
+    } else if (!strcmp(argv[i], "--standings") && i + 1 < argc) {
+      options.standings_file = argv[++i];
+    } else if (!strcmp(argv[i], "--model") && i + 1 < argc) {
+      model = argv[++i];
+    } else if (!strcmp(argv[i], "--home-ice")) {
+      home_ice = true;
+    } else if (!strcmp(argv[i], "--player-model")) {
+      options.player_model = true;
+    } else if (!strcmp(argv[i], "--serve") && i + 1 < argc) {
+      options.serve_port = std::max(0, std::min(65535, atoi(argv[++i])));
+    } else if (!strcmp(argv[i], "--rules") && i + 1 < argc) {
+      options.rules_file = argv[++i];
+    } else if (!strcmp(argv[i], "--stats") && i + 1 < argc) {
+      options.stats_file = argv[++i];
+    } else if (!strcmp(argv[i], "--league-size") && i + 1 < argc) {
+      options.league_size = std::max(1, atoi(argv[++i]));
+    } else if (!strcmp(argv[i], "--roster") && i + 1 < argc) {
+      // F=9,D=6 -- roster spots per team at each position
+      options.drafted.clear();
+      std::istringstream spots(argv[++i]);
+      std::string spot;
+      while (std::getline(spots, spot, ',')) {
+        size_t equals = spot.find('=');
+        if (equals == std::string::npos) continue;
+        options.drafted[spot.substr(0, equals)] = std::max(0, atoi(spot.c_str() + equals + 1));
+      }
+    } else if (!strcmp(argv[i], "--tail-points") && i + 1 < argc) {
+      options.tail_points = static_cast<float>(atof(argv[++i]));
+    } else if (!strcmp(argv[i], "--benchmark-models")) {
+      options.benchmark_models = true;
+    } else if (!strcmp(argv[i], "--benchmark-qmc")) {
+      options.benchmark_qmc = true;
+    } else if (!strcmp(argv[i], "--merge")) {
+      // Everything after this is a partial to merge
+      while (i + 1 < argc) {
+        options.control.merge_files.push_back(argv[++i]);
+      }
+    } else {
+      std::cout << "Ignoring unknown option " << argv[i] << std::endl;
+    }
+  }
+  // Find the compiled version of the game model we asked for
+  size_t m = 0;
+  while (m < kGameModelCount && (model != kGameModels[m].name || home_ice != kGameModels[m].home_ice)) ++m;
+  if (m < kGameModelCount) {
+    options.control.model = &kGameModels[m];
+  } else {
+    std::cout << "Unknown game model " << model << " (record, bt, poisson or table), using record" << std::endl;
+  }
+  if (home_ice && (options.control.qmc || options.control.tilt > 0)) {
+    std::cout << "Home ice only applies game by game, so --qmc and --importance play on neutral ice" << std::endl;
+  }
+
+  // Every team fills every spot
+  for (auto it = options.drafted.begin(); it != options.drafted.end(); ++it) {
+    it->second *= options.league_size;
+  }
+
+  // Shards always write their partial out, somewhere
+  if (options.control.shards > 1 && options.control.checkpoint_file.empty()) {
+    std::ostringstream partial;
+    partial << "partial_" << options.control.shard << "_of_" << options.control.shards << ".bin";
+    options.control.checkpoint_file = partial.str();
+  }
+
+  return options;
+}
+
+// Player names come in with stray non-ASCII bytes on the front, so compare without them
+std::string CleanName(std::string const& name)
+{
+  size_t first = 0;
+  size_t last = name.size();
+  while (first < last && !isgraph(static_cast<unsigned char>(name[first]))) ++first;
+  while (last > first && !isgraph(static_cast<unsigned char>(name[last-1]))) --last;
+  return name.substr(first, last - first);
+}
+
+// Each row changes one thing in one scenario -- rows with the same scenario name stack up
+//   scenario,team,PIT,won,30      -- set a team's won/lost/otlost/gf/ga
+//   scenario,player,Sidney Crosby,out
+//   scenario,player,Sidney Crosby,gp,20  -- set a player's gp/pts
+// The unchanged data always comes first as the baseline
+Scenarios GetScenarios(strtk::token_grid const& grid, Teams const& teams, Players const& players)
+{
+  Scenarios scenarios;
+
+  // Changed teams get record ids past the baseline ones
+  int next_record = static_cast<int>(teams.size());
+
+  Scenario baseline;
+  baseline.name = "baseline";
+  baseline.teams = teams;
+  baseline.players = players;
+  scenarios.push_back(baseline);
+
+  for (size_t i = 0; i < grid.row_count(); ++i) {
+    strtk::token_grid::row_type r = grid.row(i);
+    if (r.size() < 4) {
+      std::cout << "Skipping scenario row " << i << std::endl;
+      continue;
+    }
+
+    std::string name = r.get<std::string>(0);
+    std::string kind = r.get<std::string>(1);
+    std::string target = CleanName(r.get<std::string>(2));
+    std::string field = r.get<std::string>(3);
+    int value = r.size() > 4 ? r.get<int>(4) : 0;
+
+    // Find the scenario, or start a new one from the baseline
+    Scenarios::iterator sc = scenarios.begin() + 1;
+    while (sc != scenarios.end() && sc->name != name) ++sc;
+    if (sc == scenarios.end()) {
+      baseline.name = name;
+      scenarios.push_back(baseline);
+      sc = scenarios.end() - 1;
+    }
+
+    bool found = false;
+    if (kind == "team") {
+      for (auto it = sc->teams.begin(); it != sc->teams.end(); ++it) {
+        if (it->name != target) continue;
+        found = true;
+        if      (field == "won")    it->won = value;
+        else if (field == "lost")   it->lost = value;
+        else if (field == "otlost") it->otlost = value;
+        else if (field == "gf")     it->gf = value;
+        else if (field == "ga")     it->ga = value;
+        else found = false;
+        if (found && it->record < static_cast<int>(teams.size())) {
+          it->record = next_record++;
+        }
+      }
+    } else if (kind == "player") {
+      for (auto it = sc->players.begin(); it != sc->players.end(); ++it) {
+        if (CleanName(it->name) != target) continue;
+        found = true;
+        // An injured player still counts their games, they just don't score
+        if      (field == "out") it->pts = 0;
+        else if (field == "gp")  it->gp = value;
+        else if (field == "pts") it->pts = value;
+        else found = false;
+      }
+    }
+
+    if (!found) {
+      std::cout << "Scenario " << name << " couldn't apply " << kind << " " << target << " " << field << std::endl;
+    }
+  }
+
+  return scenarios;
+}
+
 bool GetTeam(std::string const& team, Teams const& teams, Team& player_team)
 {
   for (auto it = teams.cbegin(); it != teams.cend(); ++it) {
@@ -263,40 +1277,692 @@ PlayerPointsList ScorePlayers(Players const& players, Teams const& teams, TeamGa
   return pp;
 }
 
-int main_playoffs(int argc, char* argv[]) 
+// Lower case letters and digits only, with +/- spelled out -- PIM, +/- and SVPCT become pim, plusminus and svpct
+std::string ColumnName(std::string const& header)
+{
+  std::string name;
+  for (auto it = header.begin(); it != header.end(); ++it) {
+    unsigned char c = static_cast<unsigned char>(*it);
+    if (isalnum(c)) name += static_cast<char>(tolower(c));
+    else if (c == '+') name += "plus";
+    else if (c == '-') name += "minus";
+  }
+  return name;
+}
+
+// Columns for scoring rules, one row for each player:
+//   gp, pts -- from forwards.csv and defense.csv
+//   games   -- playoff games the player's team is expected to play
+// plus every column of stats_file (one of the season csv files, with a header row), matched up by name.
+// Players missing from it get zeros, and so does anything that isn't a number (like TOI).
+StatColumns MakeStatColumns(Players const& players, Teams const& teams, TeamGamesPlayed const& tgp, std::string const& stats_file)
 {
-  strtk::token_grid teams_csv("teamdata.csv");
+  StatColumns columns;
+  std::vector<float> gp;
+  std::vector<float> pts;
+  std::vector<float> games;
+  std::map<std::string, size_t> row_of;
+  for (size_t p = 0; p < players.size(); ++p) {
+    gp.push_back(static_cast<float>(players[p].gp));
+    pts.push_back(static_cast<float>(players[p].pts));
+    Team player_team;
+    bool found = GetTeam(players[p].team, teams, player_team);
+    games.push_back(found ? tgp.find(player_team)->second : 0.f);
+    row_of[CleanName(players[p].name)] = p;
+  }
+  columns.Add("gp", gp);
+  columns.Add("pts", pts);
+  columns.Add("games", games);
+
+  if (stats_file.empty()) return columns;
+
+  strtk::token_grid stats_csv(stats_file, StatFileOptions());
+  if (stats_csv.row_count() < 2) {
+    std::cout << "No stats in " << stats_file << std::endl;
+    return columns;
+  }
+
+  strtk::token_grid::row_type header = stats_csv.row(0);
+  size_t name_col = header.size();
+  for (size_t c = 0; c < header.size(); ++c) {
+    std::string name = ColumnName(header.get<std::string>(c));
+    if (name == "name" || name == "player") name_col = c;
+  }
+  if (name_col == header.size()) {
+    std::cout << "No player column in " << stats_file << std::endl;
+    return columns;
+  }
+
+  // The whole file in one pass: the player's name, then every other column as a number
+  strtk::token_grid::column_schema schema;
+  schema.add_string(name_col);
+  std::vector<size_t> stat_cols;
+  for (size_t c = 0; c < header.size(); ++c) {
+    if (c == name_col) continue;
+    schema.add_double(c);
+    stat_cols.push_back(c);
+  }
+  strtk::token_grid::column_table table;
+  stats_csv.to_columns(schema, table);
+
+  // Names are interned, so each one only gets matched to a player once however many rows it's on
+  std::vector<size_t> player_of(table.string_count(), players.size());
+  for (unsigned int id = 0; id < table.string_count(); ++id) {
+    std::map<std::string, size_t>::const_iterator row = row_of.find(CleanName(table.string(id)));
+    if (row != row_of.end()) player_of[id] = row->second;
+  }
+
+  // gp and pts are already there from the player files, so the season's own copies get dropped
+  std::vector<unsigned int> const& names = table.string_ids(0);
+  for (size_t s = 0; s < stat_cols.size(); ++s) {
+    std::vector<float> values(players.size(), 0.f);
+    std::vector<double> const& column = table.doubles(s + 1);
+    for (size_t i = 0; i < table.row_count(); ++i) {
+      size_t p = player_of[names[i]];
+      if (p != players.size() && table.is_valid(s + 1, i)) values[p] = static_cast<float>(column[i]);
+    }
+    columns.Add(ColumnName(header.get<std::string>(stat_cols[s])), values);
+  }
+  return columns;
+}
+
+// Any extra columns go on the end of each line, one row per player in the same order as ppl
+void WriteScores(std::ostream& out, PlayerPointsList const& ppl, std::vector<std::vector<float> > const* columns = NULL)
+{
+  for (size_t p = 0; p < ppl.size(); ++p) {
+    Player const& player = ppl[p].first;
+    out << std::left << std::setw(30) << player.name << player.pos << " " << std::left << std::setw(4) << player.team << std::left << std::setw(3) << player.gp << ppl[p].second;
+    if (columns) {
+      for (auto it = (*columns)[p].begin(); it != (*columns)[p].end(); ++it) {
+        out << " " << *it;
+      }
+    }
+    out << std::endl;
+  }
+}
+
+void WriteWinners(std::ostream& out, TeamGamesPlayed const& win_perc, TeamGamesPlayed const& win_error)
+{
+  for (auto it = win_perc.begin(); it != win_perc.end(); ++it) {
+    out << std::left << std::setfill(' ') << std::setw(4) << it->first.name << std::internal << std::fixed << std::setprecision(2) << std::setfill('0') << std::setw(5) << it->second * 100 << "%";
+
+    // Standard error, when we ran replicates to get one
+    TeamGamesPlayed::const_iterator err = win_error.find(it->first);
+    if (err != win_error.end()) {
+      out << " +- " << std::setprecision(3) << err->second * 100 << "%";
+    }
+    out << std::endl;
+  }
+}
+
+void WriteGamesDist(std::ostream& out, TeamGamesDist const& games_dist)
+{
+  for (auto it = games_dist.begin(); it != games_dist.end(); ++it) {
+    out << std::left << std::setw(4) << it->first.name;
+    for (auto p = it->second.begin(); p != it->second.end(); ++p) {
+      out << std::right << std::fixed << std::setprecision(2) << std::setw(7) << *p * 100;
+    }
+    out << std::endl;
+  }
+}
+
+// Conditional answer for one set of conditions -- how often they happen, then the usual winners and scores within them
+// Returns false if a condition doesn't make sense
+bool WriteConditional(std::ostream& out, RunIndex const& index, std::vector<std::string> const& conditions, Players const& players, Teams const& teams, size_t top)
+{
+  std::vector<RunCondition> parsed;
+  for (auto it = conditions.begin(); it != conditions.end(); ++it) {
+    if (CleanName(*it).empty()) continue;
+    RunCondition condition;
+    std::string error;
+    if (!ParseCondition(CleanName(*it), index, condition, error)) {
+      out << "Bad condition: " << error << std::endl;
+      return false;
+    }
+    parsed.push_back(condition);
+  }
+
+  std::chrono::steady_clock::time_point started = std::chrono::steady_clock::now();
+  ConditionalResult result = QueryRuns(index, parsed);
+  std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - started;
+
+  out << result.runs << " of " << index.runs << " runs (" << std::fixed << std::setprecision(2) << result.chance * 100 << "%), answered in " << std::setprecision(1) << elapsed.count() * 1000 << " ms" << std::endl;
+  if (!result.runs) return true;
+
+  std::ostringstream winners_block;
+  WriteWinners(winners_block, result.win_perc, TeamGamesPlayed());
+  PlayerPointsList ppl = ScorePlayers(players, teams, result.games);
+  ppl.resize(std::min(top, ppl.size()));
+  std::ostringstream scores_block;
+  WriteScores(scores_block, ppl);
+  out << winners_block.str() << std::endl << scores_block.str() << std::endl;
+  return true;
+}
+
+// Work through conditional questions from the indexed runs
+//   file -- one per row, a name then its conditions: pit_final,PIT final,!CHI round2
+//   -    -- one per line from the console, just the conditions, until a blank line
+void AnswerQueries(std::string const& query_file, RunIndex const& index, Players const& players, Teams const& teams)
+{
+  if (!index.runs) {
+    std::cout << "No runs were indexed, so there's nothing to query" << std::endl;
+    return;
+  }
+
+  if (query_file == "-") {
+    for (;;) {
+      std::cout << "query> " << std::flush;
+      std::string line;
+      if (!std::getline(std::cin, line) || CleanName(line).empty()) break;
+
+      std::vector<std::string> conditions;
+      std::istringstream fields(line);
+      std::string field;
+      while (std::getline(fields, field, ',')) conditions.push_back(field);
+      WriteConditional(std::cout, index, conditions, players, teams, 20);
+    }
+    return;
+  }
+
+  strtk::token_grid queries_csv(query_file);
+  std::ofstream out("conditional.txt");
+  for (size_t i = 0; i < queries_csv.row_count(); ++i) {
+    strtk::token_grid::row_type r = queries_csv.row(i);
+    std::vector<std::string> conditions;
+    for (size_t c = 1; c < r.size(); ++c) {
+      conditions.push_back(r.get<std::string>(c));
+    }
+    out << "== " << r.get<std::string>(0) << " ==" << std::endl;
+    WriteConditional(out, index, conditions, players, teams, players.size());
+  }
+  out.close();
+}
+
+// Everything one pass over the data files loads and works out -- the server keeps it around between requests
+struct Simulation
+{
+  Teams teams;
+  Players players;
+  Season season;
+  BracketState state;
+  Scenarios scenarios;
+  std::vector<Teams> team_sets;
+  PlayerModel player_model;
+  GameTable table;                          // every matchup's odds, for the table model
+  RunControl control;
+  RunIndex index;
+  std::vector<PlayoffResults> results;
+  PlayerPointsList ranked;                  // baseline players, best first
+  std::vector<std::vector<float> > quantiles; // extra columns for ranked, when the player model keeps sketches
+  std::map<std::string, size_t> by_name;    // where each (cleaned up) name is in ranked
+  StatColumns stats;                        // every stat we have for players, for scoring rules
+};
+
+// Read the data files and get everything ready to simulate
+bool LoadData(Options const& options, Simulation& sim)
+{
+  sim.control = options.control;
+
+  // With the season still going, every team in the league is in the running
+  std::string teams_file = !options.schedule_file.empty() && !options.standings_file.empty() ? options.standings_file : "teamdata.csv";
+  strtk::token_grid teams_csv(teams_file);
   strtk::token_grid forwards_csv("forwards.csv");
   strtk::token_grid defense_csv("defense.csv");
 
-  Teams t = GetTeams(teams_csv);
+  Teams& t = sim.teams;
+  t = GetTeams(teams_csv);
+  if (t.empty()) {
+    std::cout << "Couldn't read any teams from " << teams_file << std::endl;
+    return false;
+  }
+
+  if (!options.schedule_file.empty()) {
+    SeedByStandings(t);
+    for (size_t i = 0; i < t.size(); ++i) {
+      t[i].record = static_cast<int>(i);
+    }
+    strtk::token_grid schedule_csv(options.schedule_file);
+    if (!MakeSeason(t, sim.season) || !GetSchedule(schedule_csv, sim.season)) {
+      std::cout << "Couldn't set up the rest of the season (at most " << kConferences << " conferences of " << kMaxConferenceTeams << " teams)" << std::endl;
+      return false;
+    }
+    sim.control.season = &sim.season;
+  }
   Players fwd = GetPlayers(forwards_csv, "F");
   Players def = GetPlayers(defense_csv, "D");
   
   // Combine the players into one big list
-  Players all;
+  Players& all = sim.players;
   all.insert(all.end(), fwd.begin(), fwd.end());
   all.insert(all.end(), def.begin(), def.end());
 
-  // Run the playoffs some number of times to get average number of games played per team
-  TeamGamesPlayed win_perc;
-  TeamGamesPlayed tgp = RunPlayoffs(t, 100000, win_perc);
+  // If the playoffs are underway, only simulate what's left
+  // Format is one series per line -- team, team, wins, wins
+  if (!options.bracket_file.empty() && sim.control.season) {
+    std::cout << "Ignoring the bracket, the playoffs can't have started before the season's over" << std::endl;
+  } else if (!options.bracket_file.empty()) {
+    strtk::token_grid bracket_csv(options.bracket_file);
+    if (!GetBracketState(bracket_csv, t, sim.state)) {
+      return false;
+    }
+  }
+
+  // Every what-if gets evaluated in the same pass as the baseline, sharing its random draws
+  if (!options.scenarios_file.empty()) {
+    strtk::token_grid scenarios_csv(options.scenarios_file);
+    sim.scenarios = GetScenarios(scenarios_csv, t, all);
+  } else {
+    Scenario baseline;
+    baseline.name = "baseline";
+    baseline.teams = t;
+    baseline.players = all;
+    sim.scenarios.push_back(baseline);
+  }
+
+  for (auto it = sim.scenarios.begin(); it != sim.scenarios.end(); ++it) {
+    sim.team_sets.push_back(it->teams);
+  }
+
+  // Player columns line up with the tallies, which are in conference and seed order
+  if (options.player_model) {
+    Teams columns = t;
+    std::sort(columns.begin(), columns.end());
+    sim.player_model = MakePlayerModel(all, columns);
+    sim.control.players = &sim.player_model;
+  }
+
+  return true;
+}
+
+// Run the playoffs some number of times to get average number of games played per team, and rank the players on it
+// Keep every baseline run around if we're going to be asked about them
+bool RunSimulation(Options const& options, Simulation& sim, bool indexed)
+{
+  // Every matchup's odds up front, so a game is just a lookup
+  sim.table = PoissonTableModel::Build(sim.team_sets);
+  sim.control.setup.table = &sim.table;
+
+  sim.results = RunPlayoffs(sim.team_sets, sim.state, options.runs, sim.control, indexed ? &sim.index : NULL);
+  if (sim.results.empty()) {
+    return false;
+  }
 
   // Generate player scores based on the number of games we expect the team to play
-  PlayerPointsList ppl = ScorePlayers(all, t, tgp);
+  PlayerPointsList& ppl = sim.ranked;
+  if (options.player_model) {
+    // Straight from the simulated points instead, highest mean first
+    PlayoffResults const& baseline = sim.results.front();
+    std::vector<std::pair<float, size_t> > order;
+    for (size_t p = 0; p < sim.players.size(); ++p) {
+      order.push_back(std::make_pair(baseline.player_mean[p], p));
+    }
+    std::sort(order.begin(), order.end(), std::greater<std::pair<float, size_t> >());
 
-  // Write out the results
-  std::ofstream picks("scores.txt");
-  for (auto it = ppl.begin(); it != ppl.end(); ++it) {
-    picks << std::left << std::setw(30) << it->first.name << it->first.pos << " " << std::left << std::setw(4) << it->first.team << std::left << std::setw(3) << it->first.gp << it->second << std::endl;
+    for (auto it = order.begin(); it != order.end(); ++it) {
+      ppl.push_back(std::make_pair(sim.players[it->second], it->first));
+      if (baseline.player_sketches.empty()) continue;
+
+      // 10th percentile, median, 90th percentile, and the chance of getting to tail_points
+      KllSketch const& sketch = baseline.player_sketches[it->second];
+      std::vector<float> row(4, 0.f);
+      if (sketch.Count() > 0) {
+        row[0] = sketch.Quantile(0.1);
+        row[1] = sketch.Quantile(0.5);
+        row[2] = sketch.Quantile(0.9);
+        row[3] = static_cast<float>(1 - sketch.Rank(options.tail_points));
+      }
+      sim.quantiles.push_back(row);
+    }
+  } else {
+    ppl = ScorePlayers(sim.players, sim.teams, sim.results.front().games);
+  }
+
+  for (size_t p = 0; p < ppl.size(); ++p) {
+    sim.by_name[CleanName(ppl[p].first.name)] = p;
+  }
+
+  sim.stats = MakeStatColumns(sim.players, sim.teams, sim.results.front().games, options.stats_file);
+  return true;
+}
+
+// Score every player under each league's rule, all from the same columns
+// Format is one league per line -- name, rule
+void ScoreLeagues(std::string const& rules_file, Simulation const& sim)
+{
+  strtk::token_grid rules_csv(rules_file);
+  std::vector<std::string> names;
+  std::vector<ScoringRule> rules;
+  for (size_t i = 0; i < rules_csv.row_count(); ++i) {
+    strtk::token_grid::row_type r = rules_csv.row(i);
+    if (r.size() < 2) continue;
+
+    ScoringRule rule;
+    std::string error;
+    if (!CompileRule(r.get<std::string>(1), sim.stats, rule, error)) {
+      std::cout << "Skipping league " << r.get<std::string>(0) << ": " << error << std::endl;
+      continue;
+    }
+    names.push_back(r.get<std::string>(0));
+    rules.push_back(rule);
+  }
+
+  // Just the scoring, so the time says how many leagues we could keep up with
+  std::vector<std::vector<float> > scores(rules.size());
+  std::vector<float> stack;
+  std::chrono::steady_clock::time_point started = std::chrono::steady_clock::now();
+  for (size_t l = 0; l < rules.size(); ++l) {
+    EvaluateRule(rules[l], sim.stats, scores[l], stack);
+  }
+  std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - started;
+  std::cout << "Scored " << rules.size() << " leagues over " << sim.stats.rows << " players in " << elapsed.count() * 1000 << " ms";
+  if (elapsed.count() > 0) std::cout << " (" << static_cast<long long>(rules.size() / elapsed.count()) << " leagues/sec)";
+  std::cout << std::endl;
+
+  std::ofstream out("leagues.txt");
+  for (size_t l = 0; l < rules.size(); ++l) {
+    PlayerPointsList ppl;
+    for (size_t p = 0; p < sim.players.size(); ++p) {
+      ppl.push_back(std::make_pair(sim.players[p], scores[l][p]));
+    }
+    std::sort(ppl.begin(), ppl.end(), PlayerPointsListSorter());
+
+    std::ostringstream block;
+    WriteScores(block, ppl);
+    out << "== " << names[l] << " == " << rules[l].text << std::endl << block.str() << std::endl;
   }
+  out.close();
+}
+
+void WriteResults(Simulation const& sim)
+{
+  std::vector<PlayoffResults> const& results = sim.results;
+  if (sim.scenarios.size() > 1) {
+    // One block per scenario, each in its own stream so formatting doesn't carry over
+    std::ofstream blocks("scenarios.txt");
+    for (size_t s = 0; s < sim.scenarios.size(); ++s) {
+      std::ostringstream winners_block;
+      std::ostringstream scores_block;
+      WriteWinners(winners_block, results[s].win_perc, results[s].win_error);
+      WriteScores(scores_block, ScorePlayers(sim.scenarios[s].players, sim.scenarios[s].teams, results[s].games));
+      blocks << "== " << sim.scenarios[s].name << " ==" << std::endl << winners_block.str() << std::endl << scores_block.str() << std::endl;
+    }
+    blocks.close();
+  }
+
+  // The baseline always goes out in the usual files
+  std::ofstream picks("scores.txt");
+  WriteScores(picks, sim.ranked, sim.quantiles.empty() ? NULL : &sim.quantiles);
   picks.close();
 
   std::ofstream winners("winners.txt");
-  for (auto it = win_perc.begin(); it != win_perc.end(); ++it) {
-    winners << std::left << std::setfill(' ') << std::setw(4) << it->first.name << std::internal << std::fixed << std::setprecision(2) << std::setfill('0') << std::setw(5) << it->second * 100 << "%" << std::endl;
-  }
+  WriteWinners(winners, results.front().win_perc, results.front().win_error);
   winners.close();
 
+  std::ofstream games("games.txt");
+  WriteGamesDist(games, results.front().games_dist);
+  games.close();
+
+  // Chance of missing out, then of each seed
+  if (sim.control.season) {
+    std::ofstream seeds("seeds.txt");
+    WriteGamesDist(seeds, results.front().seed_dist);
+    seeds.close();
+  }
+}
+
+// Draft day: answers questions about the simulation in memory, one line each, fields split by commas like the csv files
+//   best,F,10,Sidney Crosby,Evgeni Malkin -- best 10 forwards (F, D or all) nobody's picked yet, given the picks so far
+//   roster,Sidney Crosby,Patrick Kane      -- expected points for each player on a roster and the total
+//   query,PIT final,!CHI round2            -- the runs where all of that happened, same as --query
+//   score,2*g + a - pim/10,10              -- best 10 players under a league's scoring rule
+//   reload                                 -- read the data files again and rerun the simulation
+//   quit / shutdown                        -- hang up, or stop the server too
+// It also follows a live draft, remembering every pick until it's told to start over:
+//   pick,Sidney Crosby,Patrick Kane         -- take players off the board, then recommend who's next
+//   unpick,Patrick Kane                     -- put them back
+//   next,10                                 -- best 10 left by value over replacement at their position
+//   top,D,10                                -- best 10 defence left by points
+//   reset                                   -- start the draft over
+class DraftServer : public LineHandler
+{
+public:
+  DraftServer(Options const& options, std::unique_ptr<Simulation> sim) : options(options), sim(std::move(sim))
+  {
+    board.Reset(this->sim->ranked, options.drafted);
+  }
+
+  ServeAction Handle(std::string const& line, std::string& reply)
+  {
+    std::chrono::steady_clock::time_point started = std::chrono::steady_clock::now();
+
+    std::vector<std::string> fields;
+    std::istringstream split(line);
+    std::string field;
+    while (std::getline(split, field, ',')) fields.push_back(CleanName(field));
+    std::string command = fields.empty() ? "" : fields[0];
+
+    std::ostringstream out;
+    ServeAction action = kServeNext;
+    if (command == "best") {
+      Best(fields, out);
+    } else if (command == "roster") {
+      Roster(fields, out);
+    } else if (command == "query") {
+      std::vector<std::string> conditions(fields.begin() + 1, fields.end());
+      WriteConditional(out, sim->index, conditions, sim->players, sim->teams, 20);
+    } else if (command == "pick" || command == "unpick") {
+      Pick(fields, command == "pick", out);
+    } else if (command == "next") {
+      size_t count = fields.size() > 1 ? static_cast<size_t>(std::max(1, atoi(fields[1].c_str()))) : 10;
+      Next(count, out);
+    } else if (command == "top") {
+      Top(fields, out);
+    } else if (command == "score") {
+      Score(fields, out);
+    } else if (command == "reset") {
+      picks.clear();
+      board.Reset(sim->ranked, options.drafted);
+      Next(5, out);
+    } else if (command == "reload") {
+      Reload(out);
+    } else if (command == "quit") {
+      action = kServeHangUp;
+    } else if (command == "shutdown") {
+      action = kServeShutDown;
+    } else {
+      out << "Commands: best,F|D|all,count,picked... roster,player... query,condition... pick,player... unpick,player... next,count top,F|D,count score,rule,count reset reload quit shutdown" << std::endl;
+    }
+    reply = out.str();
+
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - started;
+    std::ostringstream log;
+    log << command << " answered in " << std::fixed << std::setprecision(3) << elapsed.count() * 1000 << " ms";
+    std::cout << log.str() << std::endl;
+    return action;
+  }
+
+private:
+  // Walk down the rankings past anybody that's gone or plays the wrong position
+  void Best(std::vector<std::string> const& fields, std::ostream& out)
+  {
+    std::string pos = fields.size() > 1 ? fields[1] : "all";
+    size_t count = fields.size() > 2 ? static_cast<size_t>(std::max(1, atoi(fields[2].c_str()))) : 10;
+
+    std::vector<bool> picked(sim->ranked.size(), false);
+    for (size_t f = 3; f < fields.size(); ++f) {
+      std::map<std::string, size_t>::const_iterator found = sim->by_name.find(fields[f]);
+      if (found == sim->by_name.end()) {
+        out << "Don't know " << fields[f] << std::endl;
+        continue;
+      }
+      picked[found->second] = true;
+    }
+
+    PlayerPointsList available;
+    std::vector<std::vector<float> > columns;
+    for (size_t p = 0; p < sim->ranked.size() && available.size() < count; ++p) {
+      if (picked[p] || (pos != "all" && sim->ranked[p].first.pos != pos)) continue;
+      available.push_back(sim->ranked[p]);
+      if (!sim->quantiles.empty()) columns.push_back(sim->quantiles[p]);
+    }
+    WriteScores(out, available, columns.empty() ? NULL : &columns);
+  }
+
+  void Roster(std::vector<std::string> const& fields, std::ostream& out)
+  {
+    PlayerPointsList roster;
+    double total = 0;
+    for (size_t f = 1; f < fields.size(); ++f) {
+      std::map<std::string, size_t>::const_iterator found = sim->by_name.find(fields[f]);
+      if (found == sim->by_name.end()) {
+        out << "Don't know " << fields[f] << std::endl;
+        continue;
+      }
+      roster.push_back(sim->ranked[found->second]);
+      total += sim->ranked[found->second].second;
+    }
+    WriteScores(out, roster);
+    out << "Total " << total << std::endl;
+  }
+
+  // Every pick stays on the list by name, so it survives a reload that reorders the players
+  void Pick(std::vector<std::string> const& fields, bool take, std::ostream& out)
+  {
+    for (size_t f = 1; f < fields.size(); ++f) {
+      std::map<std::string, size_t>::const_iterator found = sim->by_name.find(fields[f]);
+      if (found == sim->by_name.end()) {
+        out << "Don't know " << fields[f] << std::endl;
+      } else if (take ? !board.Take(found->second) : !board.Return(found->second)) {
+        out << fields[f] << (take ? " is already gone" : " wasn't picked") << std::endl;
+      } else if (take) {
+        picks.push_back(fields[f]);
+      } else {
+        picks.erase(std::find(picks.begin(), picks.end(), fields[f]));
+      }
+    }
+    out << board.Taken() << " picked" << std::endl;
+    Next(5, out);
+  }
+
+  // Value over replacement goes on the end of each line
+  void Next(size_t count, std::ostream& out)
+  {
+    std::vector<std::pair<size_t, float> > best = board.Recommend(count);
+    PlayerPointsList players;
+    std::vector<std::vector<float> > columns;
+    for (auto it = best.begin(); it != best.end(); ++it) {
+      players.push_back(sim->ranked[it->first]);
+      columns.push_back(std::vector<float>(1, it->second));
+    }
+    WriteScores(out, players, &columns);
+  }
+
+  // A league's rule straight off the line, best players first
+  void Score(std::vector<std::string> const& fields, std::ostream& out)
+  {
+    ScoringRule rule;
+    std::string error;
+    if (!CompileRule(fields.size() > 1 ? fields[1] : "", sim->stats, rule, error)) {
+      out << error << std::endl;
+      return;
+    }
+    size_t count = fields.size() > 2 ? static_cast<size_t>(std::max(1, atoi(fields[2].c_str()))) : 10;
+
+    std::vector<float> scores;
+    std::vector<float> stack;
+    EvaluateRule(rule, sim->stats, scores, stack);
+    PlayerPointsList ppl;
+    for (size_t p = 0; p < sim->players.size(); ++p) {
+      ppl.push_back(std::make_pair(sim->players[p], scores[p]));
+    }
+    std::partial_sort(ppl.begin(), ppl.begin() + std::min(count, ppl.size()), ppl.end(), PlayerPointsListSorter());
+    ppl.resize(std::min(count, ppl.size()));
+    WriteScores(out, ppl);
+  }
+
+  void Top(std::vector<std::string> const& fields, std::ostream& out)
+  {
+    std::string pos = fields.size() > 1 ? fields[1] : "F";
+    size_t count = fields.size() > 2 ? static_cast<size_t>(std::max(1, atoi(fields[2].c_str()))) : 10;
+    std::vector<size_t> top = board.Top(pos, count);
+    PlayerPointsList players;
+    for (auto it = top.begin(); it != top.end(); ++it) {
+      players.push_back(sim->ranked[*it]);
+    }
+    WriteScores(out, players);
+  }
+
+  // Only swap the new data in once it's all worked, so a bad file doesn't leave us with nothing
+  void Reload(std::ostream& out)
+  {
+    std::unique_ptr<Simulation> fresh(new Simulation);
+    if (LoadData(options, *fresh) && RunSimulation(options, *fresh, true)) {
+      sim = std::move(fresh);
+      WriteResults(*sim);
+
+      // Same picks on the new rankings -- anybody who's dropped out of the data just goes missing
+      board.Reset(sim->ranked, options.drafted);
+      for (auto it = picks.begin(); it != picks.end(); ++it) {
+        std::map<std::string, size_t>::const_iterator found = sim->by_name.find(*it);
+        if (found != sim->by_name.end()) board.Take(found->second);
+      }
+      out << "Reloaded " << sim->teams.size() << " teams and " << sim->players.size() << " players over " << sim->index.runs << " runs" << std::endl;
+    } else {
+      out << "Reload failed, still using the old data" << std::endl;
+    }
+  }
+
+  Options options;
+  std::unique_ptr<Simulation> sim;
+  DraftBoard board;
+  std::vector<std::string> picks;
+};
+
+int main_playoffs(int argc, char* argv[]) 
+{
+  Options options = ParseOptions(argc, argv);
+
+  std::unique_ptr<Simulation> sim(new Simulation);
+  if (!LoadData(options, *sim)) {
+    return EXIT_FAILURE;
+  }
+
+  if (options.benchmark_qmc || options.benchmark_models) {
+    sim->table = PoissonTableModel::Build(std::vector<Teams>(1, sim->teams));
+    sim->control.setup.table = &sim->table;
+  }
+
+  if (options.benchmark_qmc) {
+    BenchmarkQmc(sim->teams, sim->state, sim->control.model, sim->control.setup);
+    return EXIT_SUCCESS;
+  }
+
+  if (options.benchmark_models) {
+    BenchmarkModels(sim->teams, sim->state, sim->control.setup);
+    return EXIT_SUCCESS;
+  }
+
+  if (!RunSimulation(options, *sim, !options.query_file.empty() || options.serve_port)) {
+    return EXIT_FAILURE;
+  }
+
+  // Write out the results
+  WriteResults(*sim);
+
+  if (!options.rules_file.empty()) {
+    ScoreLeagues(options.rules_file, *sim);
+  }
+
+  if (!options.query_file.empty()) {
+    AnswerQueries(options.query_file, sim->index, sim->players, sim->teams);
+  }
+
+  if (options.serve_port) {
+    DraftServer server(options, std::move(sim));
+    if (!ServeLines(static_cast<unsigned short>(options.serve_port), server)) {
+      return EXIT_FAILURE;
+    }
+  }
+
   return EXIT_SUCCESS;
-}
\ No newline at end of file
+}
@@ -0,0 +1,111 @@
+#include <algorithm>
+#include <cmath>
+
+#include "game_model.h"
+#include "player_model.h"
+
+namespace
+{
+  // Prior weight, in games, on the league-wide scoring rate -- enough to pull in a hot 5-game start
+  const float kPriorGames = 10.f;
+
+  // 32-bit integer hash (lowbias32) -- only multiplies, shifts and xors, so it vectorizes
+  inline unsigned Hash(unsigned x)
+  {
+    x ^= x >> 16;
+    x *= 0x7feb352du;
+    x ^= x >> 15;
+    x *= 0x846ca68bu;
+    x ^= x >> 16;
+    return x;
+  }
+
+  // Uniform in [0, 1) from the top 24 bits, which a float holds exactly
+  inline float Unit(unsigned x)
+  {
+    return static_cast<float>(x >> 8) * (1.f / 16777216.f);
+  }
+
+  // Roughly standard normal from three uniforms (Irwin-Hall) -- tails stop at +-3, which is plenty here
+  inline float Normal(unsigned key)
+  {
+    float sum = Unit(Hash(key)) + Unit(Hash(key + 1)) + Unit(Hash(key + 2));
+    return (sum - 1.5f) * 2.f;
+  }
+}
+
+PlayerModel MakePlayerModel(Players const& players, Teams const& teams)
+{
+  PlayerModel model;
+  model.teams = teams.size();
+
+  // League scoring rate for the prior, from players with a real sample
+  double league_pts = 0;
+  double league_gp = 0;
+  for (auto it = players.begin(); it != players.end(); ++it) {
+    if (it->gp < 10) continue;
+    league_pts += it->pts;
+    league_gp += it->gp;
+  }
+  double league_rate = league_gp > 0 ? league_pts / league_gp : 0.3;
+
+  for (auto it = players.begin(); it != players.end(); ++it) {
+    int column = static_cast<int>(teams.size());
+    for (size_t t = 0; t < teams.size(); ++t) {
+      if (teams[t].name == it->team) column = static_cast<int>(t);
+    }
+    model.team.push_back(column);
+
+    // Games the player could have dressed for so far -- what their team has played, or the whole
+    // schedule if we don't have the team. Traded players can be past it, which just means none missed.
+    int team_played = kGameTotal;
+    if (column < static_cast<int>(teams.size())) {
+      Team const& t = teams[column];
+      team_played = t.won + t.lost + t.otlost;
+    }
+
+    // Gamma(prior shape + pts, prior games + gp) -- the conjugate update for Poisson scoring
+    double shape = kPriorGames * league_rate + it->pts;
+    double rate = kPriorGames + it->gp;
+    double c = 1 / (9 * shape);
+    model.rate_mean.push_back(static_cast<float>(shape / rate));
+    model.rate_c.push_back(static_cast<float>(1 - c));
+    model.rate_s.push_back(static_cast<float>(std::sqrt(c)));
+
+    // Beta(gp + 1, missed + 1) for the chance of dressing for a game, as a mean and spread
+    int missed = std::max(0, team_played - it->gp);
+    double a = it->gp + 1.0;
+    double b = missed + 1.0;
+    model.avail_mean.push_back(static_cast<float>(a / (a + b)));
+    model.avail_sd.push_back(static_cast<float>(std::sqrt(a * b / ((a + b) * (a + b) * (a + b + 1)))));
+  }
+
+  return model;
+}
+
+void SamplePlayerPoints(PlayerModel const& model, float const* team_games, unsigned seed, unsigned run, float* points)
+{
+  int const* team = model.team.empty() ? NULL : &model.team[0];
+  float const* rate_mean = model.rate_mean.empty() ? NULL : &model.rate_mean[0];
+  float const* rate_c = model.rate_c.empty() ? NULL : &model.rate_c[0];
+  float const* rate_s = model.rate_s.empty() ? NULL : &model.rate_s[0];
+  float const* avail_mean = model.avail_mean.empty() ? NULL : &model.avail_mean[0];
+  float const* avail_sd = model.avail_sd.empty() ? NULL : &model.avail_sd[0];
+
+  // Every player gets 8 consecutive counters in this run's block
+  unsigned base = Hash(seed ^ Hash(run));
+  int n = static_cast<int>(model.size());
+  for (int i = 0; i < n; ++i) {
+    unsigned key = base + static_cast<unsigned>(i) * 8u;
+
+    // Wilson-Hilferty: a Gamma draw is its mean times (1 - 1/9k + z sqrt(1/9k))^3
+    float w = rate_c[i] + rate_s[i] * Normal(key);
+    w = std::max(w, 0.f);
+    float rate = rate_mean[i] * w * w * w;
+
+    float avail = avail_mean[i] + avail_sd[i] * Normal(key + 3);
+    avail = std::min(std::max(avail, 0.f), 1.f);
+
+    points[i] = rate * avail * team_games[team[i]];
+  }
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <vector>
+
+#include "types.h"
+
+// Per-run points for every player, with the uncertainty the straight points-per-game estimate leaves out:
+//   rate         -- points per game, drawn from a Gamma posterior (a league-wide prior plus the player's own gp and pts)
+//   availability -- share of the team's games the player dresses for, from how many regular season games they missed
+// Each run's points are rate x availability x the games the player's team played in that run.
+//
+// Everything's kept structure-of-arrays, one entry per player, so the sampling loop is straight-line arithmetic
+// over contiguous floats that the compiler can vectorize -- no branches, no transcendental calls.
+struct PlayerModel
+{
+  std::vector<int> team;              // column in the team games array, the last column for teams that aren't playing
+  std::vector<float> rate_mean;       // Gamma posterior for the scoring rate, as a mean plus the
+  std::vector<float> rate_c;          // Wilson-Hilferty constants 1 - 1/(9 shape) and sqrt(1/(9 shape))
+  std::vector<float> rate_s;
+  std::vector<float> avail_mean;      // Beta posterior for availability, as a mean and spread
+  std::vector<float> avail_sd;
+  size_t teams;                       // playoff teams, not counting the empty column
+
+  PlayerModel() : teams(0) {}
+
+  size_t size() const { return team.size(); }
+};
+
+// Build the model for these players. Team columns follow the order of teams.
+PlayerModel MakePlayerModel(Players const& players, Teams const& teams);
+
+// One run's points for every player. team_games has a column for each team, plus a zero on the end.
+// The draws come from a counter-based hash of (seed, run, player), so any run can be redone on its own.
+void SamplePlayerPoints(PlayerModel const& model, float const* team_games, unsigned seed, unsigned run, float* points);
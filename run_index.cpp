@@ -0,0 +1,333 @@
+#include <algorithm>
+#include <iterator>
+#include <sstream>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+#include "run_index.h"
+
+namespace
+{
+  // Series won over the whole playoffs -- every series win is worth exactly 4 counted games
+  int SeriesWon(float decided, unsigned char run_games)
+  {
+    return (static_cast<int>(decided) + run_games) / 4;
+  }
+
+  int PopCount(unsigned long long word)
+  {
+#if defined(__GNUC__)
+    return __builtin_popcountll(word);
+#else
+    word = word - ((word >> 1) & 0x5555555555555555ULL);
+    word = (word & 0x3333333333333333ULL) + ((word >> 2) & 0x3333333333333333ULL);
+    word = (word + (word >> 4)) & 0x0f0f0f0f0f0f0f0fULL;
+    return static_cast<int>((word * 0x0101010101010101ULL) >> 56);
+#endif
+  }
+
+  // Adds up the games matrix over whichever runs it's handed
+  struct MaskedSum
+  {
+    MaskedSum(RunIndex const& index) : index(index), banked(index.teams.size()), games(index.teams.size(), 0), wins(index.teams.size(), 0), weight(0)
+    {
+      for (size_t t = 0; t < index.teams.size(); ++t) {
+        banked[t] = index.decided.find(index.teams[t])->second;
+      }
+    }
+
+    void operator()(unsigned run)
+    {
+      double w = index.weights.empty() ? 1 : index.weights[run];
+      unsigned char const* row = &index.games[static_cast<size_t>(run) * index.teams.size()];
+      for (size_t t = 0; t < index.teams.size(); ++t) {
+        games[t] += w * row[t];
+        if (SeriesWon(banked[t], row[t]) == 4) {
+          wins[t] += w;
+        }
+      }
+      weight += w;
+    }
+
+    RunIndex const& index;
+    std::vector<float> banked;
+    std::vector<double> games;
+    std::vector<double> wins;
+    double weight;
+  };
+}
+
+int RunBitmap::LowestBit(unsigned long long word)
+{
+#if defined(__GNUC__)
+  return __builtin_ctzll(word);
+#elif defined(_MSC_VER) && defined(_M_X64)
+  unsigned long index;
+  _BitScanForward64(&index, word);
+  return static_cast<int>(index);
+#else
+  int bit = 0;
+  while (!(word & 1)) {
+    word >>= 1;
+    ++bit;
+  }
+  return bit;
+#endif
+}
+
+// Dense chunks that lost most of their runs in an intersection go back to being lists
+void RunBitmap::Shrink(Chunk& chunk)
+{
+  if (chunk.bits.empty() || chunk.count > kArrayMax) return;
+  chunk.array.reserve(chunk.count);
+  for (size_t w = 0; w < kWords; ++w) {
+    unsigned long long word = chunk.bits[w];
+    while (word) {
+      chunk.array.push_back(static_cast<unsigned short>(w * 64 + LowestBit(word)));
+      word &= word - 1;
+    }
+  }
+  std::vector<unsigned long long>().swap(chunk.bits);
+}
+
+void RunBitmap::Add(unsigned run)
+{
+  unsigned short key = static_cast<unsigned short>(run >> 16);
+  unsigned short low = static_cast<unsigned short>(run & 0xffff);
+
+  if (chunks.empty() || chunks.back().key != key) {
+    Chunk chunk;
+    chunk.key = key;
+    chunk.count = 0;
+    chunks.push_back(chunk);
+  }
+
+  Chunk& chunk = chunks.back();
+  if (chunk.bits.empty()) {
+    chunk.array.push_back(low);
+    ++chunk.count;
+
+    // Too many for a list now, switch to the bitmap
+    if (chunk.count > kArrayMax) {
+      chunk.bits.assign(kWords, 0);
+      for (auto it = chunk.array.begin(); it != chunk.array.end(); ++it) {
+        chunk.bits[*it >> 6] |= 1ULL << (*it & 63);
+      }
+      std::vector<unsigned short>().swap(chunk.array);
+    }
+  } else {
+    chunk.bits[low >> 6] |= 1ULL << (low & 63);
+    ++chunk.count;
+  }
+}
+
+RunBitmap RunBitmap::Range(unsigned runs)
+{
+  RunBitmap range;
+  for (unsigned start = 0; start < runs; start += 65536) {
+    Chunk chunk;
+    chunk.key = static_cast<unsigned short>(start >> 16);
+    chunk.count = std::min(65536u, runs - start);
+    if (chunk.count > kArrayMax) {
+      chunk.bits.assign(kWords, 0);
+      for (size_t k = 0; k < chunk.count; ++k) {
+        chunk.bits[k >> 6] |= 1ULL << (k & 63);
+      }
+    } else {
+      for (size_t k = 0; k < chunk.count; ++k) {
+        chunk.array.push_back(static_cast<unsigned short>(k));
+      }
+    }
+    range.chunks.push_back(chunk);
+  }
+  return range;
+}
+
+RunBitmap RunBitmap::And(RunBitmap const& other) const
+{
+  RunBitmap result;
+  auto a = chunks.begin();
+  auto b = other.chunks.begin();
+  while (a != chunks.end() && b != other.chunks.end()) {
+    if (a->key < b->key) { ++a; continue; }
+    if (b->key < a->key) { ++b; continue; }
+
+    Chunk chunk;
+    chunk.key = a->key;
+    chunk.count = 0;
+    if (!a->bits.empty() && !b->bits.empty()) {
+      // Both dense -- a word at a time
+      chunk.bits.resize(kWords);
+      for (size_t w = 0; w < kWords; ++w) {
+        chunk.bits[w] = a->bits[w] & b->bits[w];
+        chunk.count += PopCount(chunk.bits[w]);
+      }
+      Shrink(chunk);
+    } else if (a->bits.empty() && b->bits.empty()) {
+      // Both sparse -- walk the lists together
+      std::set_intersection(a->array.begin(), a->array.end(), b->array.begin(), b->array.end(), std::back_inserter(chunk.array));
+      chunk.count = chunk.array.size();
+    } else {
+      // One of each -- look the list up in the bitmap
+      Chunk const& list = a->bits.empty() ? *a : *b;
+      Chunk const& dense = a->bits.empty() ? *b : *a;
+      for (auto it = list.array.begin(); it != list.array.end(); ++it) {
+        if (dense.bits[*it >> 6] & (1ULL << (*it & 63))) chunk.array.push_back(*it);
+      }
+      chunk.count = chunk.array.size();
+    }
+
+    if (chunk.count) result.chunks.push_back(chunk);
+    ++a;
+    ++b;
+  }
+  return result;
+}
+
+RunBitmap RunBitmap::AndNot(RunBitmap const& other) const
+{
+  RunBitmap result;
+  auto b = other.chunks.begin();
+  for (auto a = chunks.begin(); a != chunks.end(); ++a) {
+    while (b != other.chunks.end() && b->key < a->key) ++b;
+    if (b == other.chunks.end() || b->key != a->key) {
+      result.chunks.push_back(*a);
+      continue;
+    }
+
+    Chunk chunk;
+    chunk.key = a->key;
+    chunk.count = 0;
+    if (!a->bits.empty()) {
+      // Knock the other side's runs out of a copy of ours
+      chunk.bits = a->bits;
+      if (b->bits.empty()) {
+        for (auto it = b->array.begin(); it != b->array.end(); ++it) {
+          chunk.bits[*it >> 6] &= ~(1ULL << (*it & 63));
+        }
+      } else {
+        for (size_t w = 0; w < kWords; ++w) {
+          chunk.bits[w] &= ~b->bits[w];
+        }
+      }
+      for (size_t w = 0; w < kWords; ++w) {
+        chunk.count += PopCount(chunk.bits[w]);
+      }
+      Shrink(chunk);
+    } else if (b->bits.empty()) {
+      std::set_difference(a->array.begin(), a->array.end(), b->array.begin(), b->array.end(), std::back_inserter(chunk.array));
+      chunk.count = chunk.array.size();
+    } else {
+      for (auto it = a->array.begin(); it != a->array.end(); ++it) {
+        if (!(b->bits[*it >> 6] & (1ULL << (*it & 63)))) chunk.array.push_back(*it);
+      }
+      chunk.count = chunk.array.size();
+    }
+
+    if (chunk.count) result.chunks.push_back(chunk);
+  }
+  return result;
+}
+
+long long RunBitmap::Count() const
+{
+  long long count = 0;
+  for (auto it = chunks.begin(); it != chunks.end(); ++it) {
+    count += it->count;
+  }
+  return count;
+}
+
+void RunIndex::Reset(Teams const& columns, TeamGamesPlayed const& already_decided)
+{
+  teams = columns;
+  decided = already_decided;
+  for (auto it = teams.begin(); it != teams.end(); ++it) {
+    decided[*it] += 0;
+  }
+  won.assign(teams.size(), std::vector<RunBitmap>(4));
+  games.clear();
+  weights.clear();
+  runs = 0;
+}
+
+void RunIndex::AddRun(TeamCounts const& run_games, double weight)
+{
+  size_t t = 0;
+  for (auto it = run_games.begin(); it != run_games.end(); ++it, ++t) {
+    unsigned char g = static_cast<unsigned char>(it->second);
+    games.push_back(g);
+    int series = SeriesWon(decided[it->first], g);
+    for (int k = 0; k < series; ++k) {
+      won[t][k].Add(runs);
+    }
+  }
+
+  // Only keep weights once one of them isn't 1
+  if (weight != 1 && weights.empty()) {
+    weights.assign(runs, 1.0);
+  }
+  if (!weights.empty()) {
+    weights.push_back(weight);
+  }
+
+  ++runs;
+}
+
+bool ParseCondition(std::string const& text, RunIndex const& index, RunCondition& condition, std::string& error)
+{
+  std::istringstream in(text);
+  std::string team;
+  std::string round;
+  in >> team >> round;
+
+  condition.negate = !team.empty() && team[0] == '!';
+  if (condition.negate) team.erase(0, 1);
+
+  condition.team = index.teams.size();
+  for (size_t t = 0; t < index.teams.size(); ++t) {
+    if (index.teams[t].name == team) condition.team = t;
+  }
+  if (condition.team == index.teams.size()) {
+    error = "unknown team in \"" + text + "\"";
+    return false;
+  }
+
+  if      (round == "round2")   condition.series_won = 1;
+  else if (round == "round3")   condition.series_won = 2;
+  else if (round == "final")    condition.series_won = 3;
+  else if (round == "champion") condition.series_won = 4;
+  else {
+    error = "unknown round in \"" + text + "\" (round2, round3, final or champion)";
+    return false;
+  }
+
+  return true;
+}
+
+ConditionalResult QueryRuns(RunIndex const& index, std::vector<RunCondition> const& conditions)
+{
+  RunBitmap match = RunBitmap::Range(index.runs);
+  for (auto it = conditions.begin(); it != conditions.end(); ++it) {
+    RunBitmap const& runs = index.won[it->team][it->series_won - 1];
+    match = it->negate ? match.AndNot(runs) : match.And(runs);
+  }
+
+  MaskedSum sum(index);
+  match.ForEach(sum);
+
+  ConditionalResult result;
+  result.runs = match.Count();
+  // Importance weights average out to 1, so the weighted count over all runs is the chance of the conditions,
+  // and anything within them is a ratio of weighted sums
+  result.chance = index.runs ? sum.weight / index.runs : 0;
+  for (size_t t = 0; t < index.teams.size(); ++t) {
+    Team const& team = index.teams[t];
+    double games = sum.weight > 0 ? sum.games[t] / sum.weight : 0;
+    result.games[team] = static_cast<float>(games) + index.decided.find(team)->second;
+    result.win_perc[team] = sum.weight > 0 ? static_cast<float>(sum.wins[t] / sum.weight) : 0.f;
+  }
+  return result;
+}
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "checkpoint.h"
+#include "types.h"
+
+// Set of run numbers, stored roaring-style: runs are split into chunks of 65536 by their top 16 bits,
+// and each chunk keeps either a sorted list of its low 16 bits (when sparse) or a 65536-bit bitmap (when dense)
+class RunBitmap
+{
+public:
+  // Runs have to be added in increasing order, which is how the simulation hands them out anyway
+  void Add(unsigned run);
+
+  // Every run in [0, runs)
+  static RunBitmap Range(unsigned runs);
+
+  RunBitmap And(RunBitmap const& other) const;
+  RunBitmap AndNot(RunBitmap const& other) const;
+  long long Count() const;
+
+  // Call f(run) for each run, in order
+  template <typename F>
+  void ForEach(F& f) const
+  {
+    for (auto c = chunks.begin(); c != chunks.end(); ++c) {
+      unsigned high = static_cast<unsigned>(c->key) << 16;
+      if (c->bits.empty()) {
+        for (auto it = c->array.begin(); it != c->array.end(); ++it) {
+          f(high | *it);
+        }
+      } else {
+        for (size_t w = 0; w < c->bits.size(); ++w) {
+          unsigned long long word = c->bits[w];
+          while (word) {
+            f(high | static_cast<unsigned>(w * 64 + LowestBit(word)));
+            word &= word - 1;
+          }
+        }
+      }
+    }
+  }
+
+private:
+  // Past this many runs a chunk's list takes more room than its bitmap
+  static const size_t kArrayMax = 4096;
+  static const size_t kWords = 65536 / 64;
+
+  struct Chunk
+  {
+    unsigned short key;
+    size_t count;
+    std::vector<unsigned short> array;    // sorted low bits, when sparse
+    std::vector<unsigned long long> bits; // kWords words, when dense
+  };
+
+  static int LowestBit(unsigned long long word);
+  static void Shrink(Chunk& chunk);
+
+  std::vector<Chunk> chunks; // sorted by key
+};
+
+// One event in a team's playoffs, for conditioning on
+//   PIT final      -- PIT made the final (won at least 3 series)
+//   !CHI round2    -- CHI didn't get out of the first round
+// Rounds are round2, round3, final and champion
+struct RunCondition
+{
+  size_t team;
+  int series_won;
+  bool negate;
+};
+
+// Per-run outcomes of one set of teams, kept around so conditional questions can be answered
+// without simulating again. Runs are numbered from 0 in the order they were simulated.
+struct RunIndex
+{
+  Teams teams;                                // column order of the games matrix (same as the tallies)
+  TeamGamesPlayed decided;                    // games from rounds that were already over, same in every run
+  std::vector<std::vector<RunBitmap> > won;   // [team][k-1] is the runs where the team won at least k series
+  std::vector<unsigned char> games;           // [run * teams + team] games counted in that run
+  std::vector<double> weights;                // importance weight of each run, empty when they're all 1
+  unsigned runs;
+
+  RunIndex() : runs(0) {}
+
+  // Get ready for the given teams -- decided holds the games they've already banked
+  void Reset(Teams const& columns, TeamGamesPlayed const& already_decided);
+
+  // Record the next run
+  void AddRun(TeamCounts const& run_games, double weight);
+};
+
+// What the runs matching some conditions look like
+struct ConditionalResult
+{
+  long long runs;           // how many runs matched
+  double chance;            // share of all runs (weighted) that matched
+  TeamGamesPlayed games;    // expected games, including decided rounds
+  TeamGamesPlayed win_perc; // chance of each team winning it all
+};
+
+// Turn text like "!CHI round2" into a condition, or say what's wrong with it
+bool ParseCondition(std::string const& text, RunIndex const& index, RunCondition& condition, std::string& error);
+
+// Intersect the bitmaps for every condition, then add up the games matrix over just those runs
+ConditionalResult QueryRuns(RunIndex const& index, std::vector<RunCondition> const& conditions);
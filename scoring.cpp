@@ -0,0 +1,295 @@
+#include <cctype>
+#include <cstdlib>
+#include <sstream>
+
+#include "scoring.h"
+
+int StatColumns::Find(std::string const& name) const
+{
+  for (size_t c = 0; c < names.size(); ++c) {
+    if (names[c] == name) return static_cast<int>(c);
+  }
+  return -1;
+}
+
+void StatColumns::Add(std::string const& name, std::vector<float> const& column)
+{
+  if (Find(name) >= 0) return;
+  names.push_back(name);
+  values.push_back(column);
+  rows = column.size();
+}
+
+namespace
+{
+  // Something an instruction can use: what's on top of the stack, a column, or a number
+  struct Operand
+  {
+    ScoringRule::Source source;
+    int column;
+    float number;
+  };
+
+  // Recursive descent, writing instructions as it goes
+  //   expression -- term (+|- term)*
+  //   term       -- factor (*|/ factor)*
+  //   factor     -- -factor | number | name | ( expression )
+  class Compiler
+  {
+  public:
+    Compiler(std::string const& text, StatColumns const& columns, ScoringRule& rule) : text(text), columns(columns), rule(rule), at(0), depth(0) {}
+
+    bool Run(std::string& error)
+    {
+      Operand result;
+      if (!Expression(result)) {
+        error = problem;
+        return false;
+      }
+      SkipSpaces();
+      if (at < text.size()) {
+        error = "Unexpected " + text.substr(at, 1) + " at " + Where();
+        return false;
+      }
+      Push(result);
+      return true;
+    }
+
+  private:
+    bool Expression(Operand& left)
+    {
+      if (!Term(left)) return false;
+      for (;;) {
+        SkipSpaces();
+        if (at >= text.size() || (text[at] != '+' && text[at] != '-')) return true;
+        char op = text[at++];
+        Operand right;
+        if (!Term(right)) return false;
+        Combine(left, op, right);
+      }
+    }
+
+    bool Term(Operand& left)
+    {
+      if (!Factor(left)) return false;
+      for (;;) {
+        SkipSpaces();
+        if (at >= text.size() || (text[at] != '*' && text[at] != '/')) return true;
+        char op = text[at++];
+        Operand right;
+        if (!Factor(right)) return false;
+        Combine(left, op, right);
+      }
+    }
+
+    bool Factor(Operand& operand)
+    {
+      SkipSpaces();
+      if (at >= text.size()) {
+        problem = "Rule ends too soon";
+        return false;
+      }
+
+      char c = text[at];
+      if (c == '-') {
+        ++at;
+        if (!Factor(operand)) return false;
+        if (operand.source == ScoringRule::kNumber) {
+          operand.number = -operand.number;
+        } else {
+          Push(operand);
+          Emit(ScoringRule::kNeg, operand);
+        }
+        return true;
+      }
+
+      if (c == '(') {
+        ++at;
+        if (!Expression(operand)) return false;
+        SkipSpaces();
+        if (at >= text.size() || text[at] != ')') {
+          problem = "Missing ) at " + Where();
+          return false;
+        }
+        ++at;
+        return true;
+      }
+
+      if (isdigit(static_cast<unsigned char>(c)) || c == '.') {
+        char const* start = text.c_str() + at;
+        char* end = NULL;
+        operand.source = ScoringRule::kNumber;
+        operand.number = static_cast<float>(strtod(start, &end));
+        operand.column = -1;
+        at += end - start;
+        return true;
+      }
+
+      if (isalpha(static_cast<unsigned char>(c)) || c == '_') {
+        std::string name;
+        while (at < text.size() && (isalnum(static_cast<unsigned char>(text[at])) || text[at] == '_')) {
+          name += static_cast<char>(tolower(static_cast<unsigned char>(text[at++])));
+        }
+        operand.source = ScoringRule::kColumn;
+        operand.column = columns.Find(name);
+        operand.number = 0;
+        if (operand.column < 0) {
+          problem = "No column called " + name + " (have";
+          for (auto it = columns.names.begin(); it != columns.names.end(); ++it) {
+            problem += " " + *it;
+          }
+          problem += ")";
+          return false;
+        }
+        return true;
+      }
+
+      problem = "Unexpected " + text.substr(at, 1) + " at " + Where();
+      return false;
+    }
+
+    // left = left op right, using whichever instruction needs the fewest columns moved
+    void Combine(Operand& left, char op, Operand const& right)
+    {
+      if (left.source == ScoringRule::kNumber && right.source == ScoringRule::kNumber) {
+        if      (op == '+') left.number += right.number;
+        else if (op == '-') left.number -= right.number;
+        else if (op == '*') left.number *= right.number;
+        else                left.number = right.number != 0 ? left.number / right.number : 0.f;
+        return;
+      }
+
+      // Right's already on top, so left has to come in as the source, the other way around
+      if (left.source != ScoringRule::kStack && right.source == ScoringRule::kStack) {
+        if      (op == '+') Emit(ScoringRule::kAdd, left);
+        else if (op == '-') Emit(ScoringRule::kSubBy, left);
+        else if (op == '*') Emit(ScoringRule::kMul, left);
+        else                Emit(ScoringRule::kDivBy, left);
+        left.source = ScoringRule::kStack;
+        return;
+      }
+
+      Push(left);
+      if      (op == '+') Emit(ScoringRule::kAdd, right);
+      else if (op == '-') Emit(ScoringRule::kSub, right);
+      else if (op == '*') Emit(ScoringRule::kMul, right);
+      else                Emit(ScoringRule::kDiv, right);
+    }
+
+    // Get an operand onto the stack, if it isn't already
+    void Push(Operand& operand)
+    {
+      if (operand.source == ScoringRule::kStack) return;
+      Emit(ScoringRule::kPush, operand);
+      operand.source = ScoringRule::kStack;
+    }
+
+    void Emit(ScoringRule::Op op, Operand const& operand)
+    {
+      ScoringRule::Instruction instruction;
+      instruction.op = op;
+      instruction.source = op == ScoringRule::kNeg ? ScoringRule::kNumber : operand.source;
+      instruction.column = operand.column;
+      instruction.number = operand.number;
+      rule.code.push_back(instruction);
+
+      if (op == ScoringRule::kPush) {
+        ++depth;
+        if (depth > rule.depth) rule.depth = depth;
+      } else if (instruction.source == ScoringRule::kStack) {
+        --depth;
+      }
+    }
+
+    void SkipSpaces()
+    {
+      while (at < text.size() && isspace(static_cast<unsigned char>(text[at]))) ++at;
+    }
+
+    std::string Where() const
+    {
+      std::ostringstream where;
+      where << "column " << at + 1;
+      return where.str();
+    }
+
+    std::string const& text;
+    StatColumns const& columns;
+    ScoringRule& rule;
+    size_t at;
+    size_t depth;
+    std::string problem;
+  };
+
+  struct Add   { float operator()(float top, float source) const { return top + source; } };
+  struct Sub   { float operator()(float top, float source) const { return top - source; } };
+  struct SubBy { float operator()(float top, float source) const { return source - top; } };
+  struct Mul   { float operator()(float top, float source) const { return top * source; } };
+  struct Div   { float operator()(float top, float source) const { return source != 0 ? top / source : 0.f; } };
+  struct DivBy { float operator()(float top, float source) const { return top != 0 ? source / top : 0.f; } };
+  struct Neg   { float operator()(float top, float) const { return -top; } };
+
+  // One instruction over every row -- either against a column or the same number each time, so both loops vectorize
+  template <class F>
+  void Apply(float* top, float const* source, float number, size_t rows)
+  {
+    F f;
+    if (source) {
+      for (size_t i = 0; i < rows; ++i) top[i] = f(top[i], source[i]);
+    } else {
+      for (size_t i = 0; i < rows; ++i) top[i] = f(top[i], number);
+    }
+  }
+}
+
+bool CompileRule(std::string const& text, StatColumns const& columns, ScoringRule& rule, std::string& error)
+{
+  rule = ScoringRule();
+  rule.text = text;
+  Compiler compiler(text, columns, rule);
+  return compiler.Run(error);
+}
+
+void EvaluateRule(ScoringRule const& rule, StatColumns const& columns, std::vector<float>& scores, std::vector<float>& stack)
+{
+  size_t rows = columns.rows;
+  scores.assign(rows, 0.f);
+  if (!rows || rule.code.empty()) return;
+
+  stack.resize(rule.depth * rows);
+  float* base = &stack[0];
+  size_t top = 0; // slots in use
+
+  for (auto it = rule.code.begin(); it != rule.code.end(); ++it) {
+    float const* source = NULL;
+    if (it->source == ScoringRule::kColumn) {
+      source = &columns.values[it->column][0];
+    } else if (it->source == ScoringRule::kStack) {
+      source = base + --top * rows;
+    }
+
+    if (it->op == ScoringRule::kPush) {
+      float* slot = base + top++ * rows;
+      if (source) {
+        for (size_t i = 0; i < rows; ++i) slot[i] = source[i];
+      } else {
+        for (size_t i = 0; i < rows; ++i) slot[i] = it->number;
+      }
+      continue;
+    }
+
+    float* slot = base + (top - 1) * rows;
+    switch (it->op) {
+      case ScoringRule::kAdd:   Apply<Add>(slot, source, it->number, rows); break;
+      case ScoringRule::kSub:   Apply<Sub>(slot, source, it->number, rows); break;
+      case ScoringRule::kSubBy: Apply<SubBy>(slot, source, it->number, rows); break;
+      case ScoringRule::kMul:   Apply<Mul>(slot, source, it->number, rows); break;
+      case ScoringRule::kDiv:   Apply<Div>(slot, source, it->number, rows); break;
+      case ScoringRule::kDivBy: Apply<DivBy>(slot, source, it->number, rows); break;
+      case ScoringRule::kNeg:   Apply<Neg>(slot, NULL, 0.f, rows); break;
+      default: break;
+    }
+  }
+
+  scores.assign(base, base + rows);
+}
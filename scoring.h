@@ -0,0 +1,68 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+// Player stats a column at a time, one row per player in every column
+struct StatColumns
+{
+  StatColumns() : rows(0) {}
+
+  // Column number for a name, or -1
+  int Find(std::string const& name) const;
+
+  // The first column with a name wins -- later ones with the same name are dropped
+  void Add(std::string const& name, std::vector<float> const& column);
+
+  std::vector<std::string> names;
+  std::vector<std::vector<float> > values;
+  size_t rows;
+};
+
+// A league's scoring rule, like 2*g + a + 0.5*ppg - pim/10
+// Numbers, column names, + - * / and brackets, with the usual precedence. Dividing by zero gives zero.
+//
+// Rules compile to a flat list of instructions for a stack machine where every stack slot is a whole column,
+// so each instruction is one tight loop over every player. An operand that's a column or a number goes straight
+// into the instruction instead of onto the stack, and numbers on their own get worked out while compiling.
+struct ScoringRule
+{
+  enum Op
+  {
+    kPush,   // push source
+    kAdd,    // top = top + source
+    kSub,    // top = top - source
+    kSubBy,  // top = source - top
+    kMul,    // top = top * source
+    kDiv,    // top = top / source
+    kDivBy,  // top = source / top
+    kNeg     // top = -top
+  };
+
+  enum Source
+  {
+    kStack,  // popped off the top (the second from the top becomes the top)
+    kColumn,
+    kNumber
+  };
+
+  struct Instruction
+  {
+    Op op;
+    Source source;
+    int column;
+    float number;
+  };
+
+  ScoringRule() : depth(0) {}
+
+  std::string text;
+  std::vector<Instruction> code;
+  size_t depth; // most columns on the stack at once
+};
+
+// False with a message in error if the rule doesn't parse or names a column we don't have
+bool CompileRule(std::string const& text, StatColumns const& columns, ScoringRule& rule, std::string& error);
+
+// One score per row. stack is scratch space that gets reused between calls, so keep it around when scoring lots of rules.
+void EvaluateRule(ScoringRule const& rule, StatColumns const& columns, std::vector<float>& scores, std::vector<float>& stack);
@@ -0,0 +1,179 @@
+#include <algorithm>
+
+#include "season.h"
+
+namespace
+{
+  const int kMaxTeams = kConferences * kMaxConferenceTeams;
+
+  // Everything the tiebreakers look at, packed so a bigger number is a better standing:
+  // points, then fewer games played, then wins, then the better current seed
+  unsigned StandingKey(int points, int played, int wins, int seed)
+  {
+    return (static_cast<unsigned>(points) << 24) | (static_cast<unsigned>(255 - played) << 16) | (static_cast<unsigned>(wins) << 8) | static_cast<unsigned>(255 - seed);
+  }
+
+  int Points(Team const& t)
+  {
+    return 2 * t.won + t.otlost;
+  }
+
+  int Played(Team const& t)
+  {
+    return t.won + t.lost + t.otlost;
+  }
+
+  struct StandingSorter
+  {
+    bool operator()(Team const& a, Team const& b) const
+    {
+      unsigned ka = StandingKey(Points(a), Played(a), a.won, 0);
+      unsigned kb = StandingKey(Points(b), Played(b), b.won, 0);
+      return ka != kb ? ka > kb : a.name < b.name;
+    }
+  };
+
+  // Batcher's odd-even merge sort for a full conference -- the same compare-exchanges every time,
+  // so there's no branching on the data and a short conference just gets padded out with zeroes
+  struct SortingNetwork
+  {
+    SortingNetwork()
+    {
+      const int n = kMaxConferenceTeams;
+      for (int p = 1; p < n; p *= 2) {
+        for (int k = p; k >= 1; k /= 2) {
+          for (int j = k % p; j + k < n; j += 2 * k) {
+            for (int i = 0; i < k && i + j + k < n; ++i) {
+              if ((i + j) / (2 * p) == (i + j + k) / (2 * p)) {
+                pairs.push_back(std::make_pair(i + j, i + j + k));
+              }
+            }
+          }
+        }
+      }
+    }
+
+    // Best standing first
+    void Sort(unsigned keys[kMaxConferenceTeams]) const
+    {
+      for (auto it = pairs.begin(); it != pairs.end(); ++it) {
+        unsigned a = keys[it->first];
+        unsigned b = keys[it->second];
+        keys[it->first] = std::max(a, b);
+        keys[it->second] = std::min(a, b);
+      }
+    }
+
+    std::vector<std::pair<int, int> > pairs;
+  };
+}
+
+void SeedByStandings(Teams& teams)
+{
+  std::sort(teams.begin(), teams.end(), StandingSorter());
+
+  std::vector<char> confs;
+  std::vector<int> next_seed;
+  for (auto it = teams.begin(); it != teams.end(); ++it) {
+    size_t c = std::find(confs.begin(), confs.end(), it->conf) - confs.begin();
+    if (c == confs.size()) {
+      confs.push_back(it->conf);
+      next_seed.push_back(1);
+    }
+    it->seed = next_seed[c]++;
+  }
+
+  // Back into conference and seed order like everywhere else
+  std::sort(teams.begin(), teams.end());
+}
+
+bool MakeSeason(Teams const& teams, Season& season)
+{
+  if (teams.size() > static_cast<size_t>(kMaxTeams)) {
+    return false;
+  }
+
+  season.teams = teams;
+  int conferences = 0;
+  int otlost = 0;
+  int played = 0;
+  for (size_t slot = 0; slot < teams.size(); ++slot) {
+    int c = 0;
+    while (c < conferences && season.names[c] != teams[slot].conf) ++c;
+    if (c == conferences) {
+      if (conferences == kConferences) return false;
+      season.names[c] = teams[slot].conf;
+      season.sizes[c] = 0;
+      ++conferences;
+    }
+    if (season.sizes[c] == kMaxConferenceTeams) return false;
+    season.members[c][season.sizes[c]++] = static_cast<int>(slot);
+
+    otlost += teams[slot].otlost;
+    played += Played(teams[slot]);
+  }
+  for (int c = conferences; c < kConferences; ++c) {
+    season.names[c] = 0;
+    season.sizes[c] = 0;
+  }
+
+  // Every game that went past regulation left exactly one team with an overtime loss
+  season.overtime = played ? 2.0 * otlost / played : 0;
+  return true;
+}
+
+Teams SimulateSeason(Season const& season, Teams const& teams, SeriesRng& eng)
+{
+  static const SortingNetwork network;
+
+  // Start from the standings as they are
+  int points[kMaxTeams];
+  int played[kMaxTeams];
+  int wins[kMaxTeams];
+  double share[kMaxTeams];
+  for (size_t slot = 0; slot < teams.size(); ++slot) {
+    points[slot] = Points(teams[slot]);
+    played[slot] = Played(teams[slot]);
+    wins[slot] = teams[slot].won;
+    share[slot] = played[slot] ? static_cast<double>(teams[slot].won) / played[slot] : 0.5;
+  }
+
+  // Play the rest of the schedule, one game at a time
+  for (auto it = season.games.begin(); it != season.games.end(); ++it) {
+    double p = share[it->home] * (1 - share[it->away]);
+    double q = share[it->away] * (1 - share[it->home]);
+    double home_wins = p + q > 0 ? p / (p + q) : 0.5;
+
+    bool home = eng.Uniform() < home_wins;
+    int winner = home ? it->home : it->away;
+    int loser = home ? it->away : it->home;
+    points[winner] += 2;
+    wins[winner] += 1;
+    if (eng.Uniform() < season.overtime) {
+      points[loser] += 1;
+    }
+    played[it->home] += 1;
+    played[it->away] += 1;
+  }
+
+  // Rank each conference and take the top of it
+  Teams playoff_teams;
+  for (int c = 0; c < kConferences; ++c) {
+    unsigned keys[kMaxConferenceTeams] = { 0 };
+    for (int k = 0; k < season.sizes[c]; ++k) {
+      int slot = season.members[c][k];
+      keys[k] = StandingKey(points[slot], played[slot], wins[slot], teams[slot].seed);
+    }
+    network.Sort(keys);
+
+    // The current seed is in the low byte and is unique in the conference, so it leads back to the team
+    for (int k = 0; k < std::min(kPlayoffSeeds, season.sizes[c]); ++k) {
+      int current_seed = 255 - static_cast<int>(keys[k] & 255);
+      Team t = teams[season.members[c][current_seed - 1]];
+      t.seed = k + 1;
+      playoff_teams.push_back(t);
+    }
+  }
+
+  return playoff_teams;
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <vector>
+
+#include "series_rng.h"
+#include "types.h"
+
+// Standings are kept in fixed arrays -- two conferences of up to 16 teams each
+const int kMaxConferenceTeams = 16;
+const int kConferences = 2;
+
+// Teams per conference that make the playoffs
+const int kPlayoffSeeds = 8;
+
+// One game left on the schedule, as slots into Season::teams
+struct ScheduledGame
+{
+  unsigned char home;
+  unsigned char away;
+};
+
+// What's left of the regular season. Teams get seeded by where they stand right now,
+// which keeps them apart as map keys -- the seeds they end up with get worked out for each run.
+struct Season
+{
+  Teams teams;                       // every team, in slot order
+  std::vector<ScheduledGame> games;  // still to play
+  double overtime;                   // share of games that go past regulation (the loser still gets a point)
+  int members[kConferences][kMaxConferenceTeams]; // slots in each conference, best standing first
+  int sizes[kConferences];
+  char names[kConferences];
+};
+
+// Orders every team in each conference by points, then fewest games played, then wins, and seeds them 1..n
+void SeedByStandings(Teams& teams);
+
+// Set up the standings engine for these teams (already seeded by SeedByStandings)
+// Returns false if they don't fit -- more than two conferences, or too many teams in one
+bool MakeSeason(Teams const& teams, Season& season);
+
+// Play out the rest of the schedule once and seed the playoffs from the final standings
+// teams line up with season.teams, but can have different records (scenarios)
+// Returns the playoff teams with the seeds they got in this run
+Teams SimulateSeason(Season const& season, Teams const& teams, SeriesRng& eng);
@@ -0,0 +1,34 @@
+#pragma once
+
+// Small splitmix64 generator -- cheap to seed, which matters since every series (and every run of the season) gets a fresh one
+struct SeriesRng
+{
+  typedef unsigned result_type;
+
+  explicit SeriesRng(unsigned long long seed) : state(seed) {}
+
+  static result_type min() { return 0; }
+  static result_type max() { return 0xffffffffu; }
+
+  result_type operator()()
+  {
+    unsigned long long z = (state += 0x9e3779b97f4a7c15ull);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+    return static_cast<result_type>((z ^ (z >> 31)) >> 32);
+  }
+
+  // Uniform in (0, 1)
+  double Uniform()
+  {
+    return ((*this)() + 0.5) / 4294967296.0;
+  }
+
+  // Uniform integer between 1 and n (multiply-shift, so no division in the hot loop)
+  int Roll(int n)
+  {
+    return 1 + static_cast<int>((static_cast<unsigned long long>((*this)()) * n) >> 32);
+  }
+
+  unsigned long long state;
+};
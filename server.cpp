@@ -0,0 +1,130 @@
+#include <cstring>
+#include <iostream>
+
+#ifdef _WIN32
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#pragma comment(lib, "ws2_32.lib")
+#else
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+#include "server.h"
+
+namespace
+{
+#ifdef _WIN32
+  typedef SOCKET Socket;
+
+  void CloseSocket(Socket s)
+  {
+    closesocket(s);
+  }
+#else
+  typedef int Socket;
+  const Socket INVALID_SOCKET = -1;
+
+  void CloseSocket(Socket s)
+  {
+    close(s);
+  }
+#endif
+
+#ifdef MSG_NOSIGNAL
+  const int kSendFlags = MSG_NOSIGNAL; // a client going away shouldn't kill the server with SIGPIPE
+#else
+  const int kSendFlags = 0;
+#endif
+
+  bool SendAll(Socket s, std::string const& data)
+  {
+    size_t sent = 0;
+    while (sent < data.size()) {
+      int n = send(s, data.data() + sent, static_cast<int>(data.size() - sent), kSendFlags);
+      if (n <= 0) return false;
+      sent += n;
+    }
+    return true;
+  }
+
+  // Answer lines from one client until it hangs up or the handler says otherwise
+  ServeAction ServeClient(Socket client, LineHandler& handler)
+  {
+    std::string pending;
+    char buffer[4096];
+    for (;;) {
+      int n = recv(client, buffer, sizeof(buffer), 0);
+      if (n <= 0) return kServeHangUp;
+      pending.append(buffer, n);
+
+      size_t end;
+      while ((end = pending.find('\n')) != std::string::npos) {
+        std::string line = pending.substr(0, end);
+        pending.erase(0, end + 1);
+        if (!line.empty() && line[line.size() - 1] == '\r') line.erase(line.size() - 1);
+
+        std::string reply;
+        ServeAction action = handler.Handle(line, reply);
+        if (!reply.empty() && reply[reply.size() - 1] != '\n') reply += '\n';
+        reply += ".\n";
+        if (!SendAll(client, reply)) return kServeHangUp;
+        if (action != kServeNext) return action;
+      }
+    }
+  }
+}
+
+bool ServeLines(unsigned short port, LineHandler& handler)
+{
+#ifdef _WIN32
+  WSADATA wsa;
+  if (WSAStartup(MAKEWORD(2, 2), &wsa) != 0) {
+    std::cout << "Couldn't start Winsock" << std::endl;
+    return false;
+  }
+#endif
+
+  Socket listener = socket(AF_INET, SOCK_STREAM, 0);
+  if (listener == INVALID_SOCKET) {
+    std::cout << "Couldn't open a socket" << std::endl;
+    return false;
+  }
+
+  // Restarting straight after a shutdown shouldn't have to wait for the old port to time out
+  int yes = 1;
+  setsockopt(listener, SOL_SOCKET, SO_REUSEADDR, reinterpret_cast<char const*>(&yes), sizeof(yes));
+
+  // Only this machine gets to ask
+  sockaddr_in address;
+  memset(&address, 0, sizeof(address));
+  address.sin_family = AF_INET;
+  address.sin_port = htons(port);
+  address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  if (bind(listener, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 || listen(listener, 4) != 0) {
+    std::cout << "Couldn't listen on port " << port << std::endl;
+    CloseSocket(listener);
+    return false;
+  }
+  std::cout << "Listening on 127.0.0.1:" << port << std::endl;
+
+  ServeAction action = kServeNext;
+  while (action != kServeShutDown) {
+    Socket client = accept(listener, NULL, NULL);
+    if (client == INVALID_SOCKET) continue;
+
+    // Replies are small and somebody's waiting on each one, so don't hold them back to fill a packet
+    setsockopt(client, IPPROTO_TCP, TCP_NODELAY, reinterpret_cast<char const*>(&yes), sizeof(yes));
+    action = ServeClient(client, handler);
+    CloseSocket(client);
+  }
+
+  CloseSocket(listener);
+#ifdef _WIN32
+  WSACleanup();
+#endif
+  return true;
+}
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <string>
+
+// What to do after answering a request
+enum ServeAction
+{
+  kServeNext,     // wait for the next line
+  kServeHangUp,   // close this connection and wait for another
+  kServeShutDown  // close everything and return
+};
+
+// Turns one line from a client into a reply
+class LineHandler
+{
+public:
+  virtual ~LineHandler() {}
+  virtual ServeAction Handle(std::string const& line, std::string& reply) = 0;
+};
+
+// Listen on 127.0.0.1:port and answer each line a client sends, one client at a time, until the handler
+// says to shut down. Every reply ends with a line holding just a dot, so a client knows when to stop reading.
+// Returns false if the port couldn't be opened.
+bool ServeLines(unsigned short port, LineHandler& handler);
@@ -0,0 +1,74 @@
+#pragma once
+
+// Sobol low-discrepancy points, enough dimensions for one point per simulated bracket
+// (8 + 4 + 2 + 1 series). Direction numbers are the first entries of Joe & Kuo's new-joe-kuo-6.21201 set.
+class Sobol
+{
+public:
+  static const int kDims = 16;
+  static const int kBits = 32;
+
+  Sobol()
+  {
+    // Primitive polynomial degree, its coefficients, then the starting m_i for dimensions 2..16
+    static const unsigned kDegree[kDims] = { 0, 1, 2, 3, 3, 4, 4, 5, 5, 5, 5, 5, 5, 6, 6, 6 };
+    static const unsigned kCoeffs[kDims] = { 0, 0, 1, 1, 2, 1, 4, 2, 4, 7, 11, 13, 14, 1, 13, 16 };
+    static const unsigned kInitial[kDims][6] = {
+      { 0 },
+      { 1 },
+      { 1, 3 },
+      { 1, 3, 1 },
+      { 1, 1, 1 },
+      { 1, 1, 3, 3 },
+      { 1, 3, 5, 13 },
+      { 1, 1, 5, 5, 17 },
+      { 1, 1, 5, 5, 5 },
+      { 1, 1, 7, 11, 19 },
+      { 1, 1, 5, 1, 1 },
+      { 1, 1, 1, 3, 11 },
+      { 1, 3, 5, 5, 31 },
+      { 1, 3, 3, 9, 7, 49 },
+      { 1, 1, 1, 15, 21, 21 },
+      { 1, 3, 1, 13, 27, 49 },
+    };
+
+    // First dimension is just van der Corput
+    for (int k = 0; k < kBits; ++k) {
+      directions_[0][k] = 1u << (kBits - 1 - k);
+    }
+
+    for (int d = 1; d < kDims; ++d) {
+      unsigned s = kDegree[d];
+      unsigned a = kCoeffs[d];
+      for (unsigned k = 0; k < s; ++k) {
+        directions_[d][k] = kInitial[d][k] << (kBits - 1 - k);
+      }
+      for (unsigned k = s; k < static_cast<unsigned>(kBits); ++k) {
+        unsigned v = directions_[d][k - s] ^ (directions_[d][k - s] >> s);
+        for (unsigned j = 1; j < s; ++j) {
+          if ((a >> (s - 1 - j)) & 1) {
+            v ^= directions_[d][k - j];
+          }
+        }
+        directions_[d][k] = v;
+      }
+    }
+  }
+
+  // Coordinate dim of point index, as a 32-bit fraction
+  // Works straight from the index (Gray code order) so any run can be generated on its own
+  unsigned Point(unsigned index, int dim) const
+  {
+    unsigned gray = index ^ (index >> 1);
+    unsigned x = 0;
+    for (int k = 0; gray; ++k, gray >>= 1) {
+      if (gray & 1) {
+        x ^= directions_[dim][k];
+      }
+    }
+    return x;
+  }
+
+private:
+  unsigned directions_[kDims][kBits];
+};
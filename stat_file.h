@@ -0,0 +1,17 @@
+#pragma once
+
+#include "strtk/strtk.hpp"
+
+// How the season stat dumps get loaded. They're big and hardly ever change between runs, so they get
+// mapped instead of copied and their index is kept next to them (file.csv.idx).
+// Columns split on the token_grid file name constructor's delimiters, which leave out the space the
+// options default adds -- player names have spaces in them.
+inline strtk::token_grid::options StatFileOptions()
+{
+  strtk::token_grid::options options;
+  options.set_column_delimiters(",|;\t");
+  options.set_memory_map(true);
+  options.set_parallel_index(true);
+  options.set_index_file(true);
+  return options;
+}
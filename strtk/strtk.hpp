@@ -23,6 +23,8 @@
 #include <cerrno>
 #include <cmath>
 #include <cstddef>
+#include <cstdio>
+#include <cstdlib>
 #include <cstring>
 #include <deque>
 #include <exception>
@@ -64,6 +66,60 @@
    #include <boost/regex.hpp>
 #endif
 
+// Memory mapped files for token_grid
+#ifdef WIN32
+   #ifndef NOMINMAX
+      #define NOMINMAX
+   #endif
+   #ifndef WIN32_LEAN_AND_MEAN
+      #define WIN32_LEAN_AND_MEAN
+   #endif
+   #include <windows.h>
+#else
+   #include <fcntl.h>
+   #include <sys/mman.h>
+   #include <sys/stat.h>
+   #include <unistd.h>
+#endif
+
+// Parallel row indexing for token_grid
+#ifdef _OPENMP
+   #include <omp.h>
+#endif
+
+// Vectorized delimiter scanning, with whatever the compiler's been told it can use
+#ifndef strtk_no_simd
+   #if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+      #define strtk_enable_sse2
+   #endif
+   #if defined(__SSSE3__) || defined(__AVX__)
+      #define strtk_enable_ssse3
+   #endif
+   #if defined(__AVX2__)
+      #define strtk_enable_avx2
+   #endif
+#endif
+
+#ifdef strtk_enable_sse2
+   #include <emmintrin.h>
+#endif
+
+#ifdef strtk_enable_ssse3
+   #include <tmmintrin.h>
+#endif
+
+#ifdef strtk_enable_avx2
+   #include <immintrin.h>
+#endif
+
+#if defined(strtk_enable_sse2) && defined(__PCLMUL__)
+   #include <wmmintrin.h>
+#endif
+
+#if defined(strtk_enable_sse2) && defined(_MSC_VER)
+   #include <intrin.h>
+#endif
+
 
 namespace strtk
 {
@@ -1056,6 +1112,147 @@ namespace strtk
    private:
 
       static const std::size_t table_size = 256;
+      static const std::size_t max_compare_delimiters = 8;
+
+   public:
+
+      #ifdef strtk_enable_sse2
+      // Classifies block_classifier::size chars at once, as a mask with bit i set when block[i] is a
+      // delimiter - with a nibble shuffle lookup given SSSE3 or AVX2, otherwise by comparing against
+      // each delimiter in turn, as long as there are few enough of them (enabled() says whether there
+      // are). Holds its vectors in registers, so make one on the stack for each run through a buffer.
+      class block_classifier
+      {
+      public:
+
+         #ifdef strtk_enable_avx2
+            static const std::size_t size = 32;
+         #else
+            static const std::size_t size = 16;
+         #endif
+
+         explicit block_classifier(const multiple_char_delimiter_predicate& predicate)
+         : count_(predicate.delimiter_count_)
+         {
+            #if defined(strtk_enable_avx2)
+               lookup_low_  = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(predicate.lookup_[0])));
+               lookup_high_ = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(predicate.lookup_[1])));
+            #elif defined(strtk_enable_ssse3)
+               lookup_low_  = _mm_loadu_si128(reinterpret_cast<const __m128i*>(predicate.lookup_[0]));
+               lookup_high_ = _mm_loadu_si128(reinterpret_cast<const __m128i*>(predicate.lookup_[1]));
+            #else
+               for (std::size_t i = 0; (i < count_) && (i < max_compare_delimiters); ++i)
+               {
+                  delimiter_[i] = _mm_set1_epi8(static_cast<char>(predicate.delimiter_list_[i]));
+               }
+            #endif
+         }
+
+         inline bool enabled() const
+         {
+            #if defined(strtk_enable_ssse3)
+               return true;
+            #else
+               return (count_ <= max_compare_delimiters);
+            #endif
+         }
+
+         #if defined(strtk_enable_avx2)
+         inline unsigned int operator()(const unsigned char* begin) const
+         {
+            const __m256i bits   = _mm256_setr_epi8(1,2,4,8,16,32,64,-128,1,2,4,8,16,32,64,-128,
+                                                    1,2,4,8,16,32,64,-128,1,2,4,8,16,32,64,-128);
+            const __m256i nibble = _mm256_set1_epi8(0x0F);
+            const __m256i zero   = _mm256_setzero_si256();
+            const __m256i block  = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(begin));
+            const __m256i low    = _mm256_and_si256(block,nibble);
+            const __m256i high   = _mm256_and_si256(_mm256_srli_epi16(block,4),nibble);
+            const __m256i upper  = _mm256_cmpgt_epi8(zero,block);
+            const __m256i row    = _mm256_blendv_epi8(_mm256_shuffle_epi8(lookup_low_,low),
+                                                      _mm256_shuffle_epi8(lookup_high_,low),
+                                                      upper);
+            const __m256i miss   = _mm256_cmpeq_epi8(_mm256_and_si256(row,_mm256_shuffle_epi8(bits,high)),zero);
+            return ~static_cast<unsigned int>(_mm256_movemask_epi8(miss));
+         }
+         #elif defined(strtk_enable_ssse3)
+         inline unsigned int operator()(const unsigned char* begin) const
+         {
+            const __m128i bits   = _mm_setr_epi8(1,2,4,8,16,32,64,-128,1,2,4,8,16,32,64,-128);
+            const __m128i nibble = _mm_set1_epi8(0x0F);
+            const __m128i zero   = _mm_setzero_si128();
+            const __m128i block  = _mm_loadu_si128(reinterpret_cast<const __m128i*>(begin));
+            const __m128i low    = _mm_and_si128(block,nibble);
+            const __m128i high   = _mm_and_si128(_mm_srli_epi16(block,4),nibble);
+            const __m128i upper  = _mm_cmplt_epi8(block,zero);
+            const __m128i row    = _mm_or_si128(_mm_andnot_si128(upper,_mm_shuffle_epi8(lookup_low_,low)),
+                                                _mm_and_si128(upper,_mm_shuffle_epi8(lookup_high_,low)));
+            const __m128i miss   = _mm_cmpeq_epi8(_mm_and_si128(row,_mm_shuffle_epi8(bits,high)),zero);
+            return static_cast<unsigned int>(~_mm_movemask_epi8(miss)) & 0xFFFF;
+         }
+         #else
+         inline unsigned int operator()(const unsigned char* begin) const
+         {
+            const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(begin));
+            __m128i match = _mm_setzero_si128();
+            for (std::size_t i = 0; i < count_; ++i)
+            {
+               match = _mm_or_si128(match,_mm_cmpeq_epi8(block,delimiter_[i]));
+            }
+            return static_cast<unsigned int>(_mm_movemask_epi8(match));
+         }
+         #endif
+
+         static inline unsigned int first_set_bit(const unsigned int mask)
+         {
+            #ifdef _MSC_VER
+               unsigned long index = 0;
+               _BitScanForward(&index,mask);
+               return static_cast<unsigned int>(index);
+            #else
+               return static_cast<unsigned int>(__builtin_ctz(mask));
+            #endif
+         }
+
+      private:
+
+         std::size_t count_;
+         #if defined(strtk_enable_avx2)
+            __m256i lookup_low_;
+            __m256i lookup_high_;
+         #elif defined(strtk_enable_ssse3)
+            __m128i lookup_low_;
+            __m128i lookup_high_;
+         #else
+            __m128i delimiter_[max_compare_delimiters];
+         #endif
+      };
+
+      friend class block_classifier;
+
+      // Calls visitor(position) for every delimiter in order, a block at a time. Returns where it
+      // stopped, which leaves less than a block (or everything, if there are too many delimiters
+      // for the block_classifier) for the caller to go through a char at a time.
+      template <typename Visitor>
+      inline const unsigned char* scan(const unsigned char* begin, const unsigned char* end, Visitor& visitor) const
+      {
+         const block_classifier classify(*this);
+         if (!classify.enabled())
+            return begin;
+         while (static_cast<std::size_t>(end - begin) >= block_classifier::size)
+         {
+            unsigned int mask = classify(begin);
+            while (0 != mask)
+            {
+               visitor(begin + block_classifier::first_set_bit(mask));
+               mask &= mask - 1;
+            }
+            begin += block_classifier::size;
+         }
+         return begin;
+      }
+      #endif
+
+   private:
 
       template <typename Iterator>
       inline void setup_delimiter_table(const Iterator begin, const Iterator end)
@@ -1065,9 +1262,27 @@ namespace strtk
          {
             delimiter_table_[static_cast<unsigned char>(*itr)] = true;
          }
+
+         // Bit (c >> 4) & 7 of lookup_[c >> 7][c & 0x0F] says whether c is a delimiter, so a block of
+         // chars can be classified with a couple of shuffles on their nibbles
+         std::fill_n(lookup_[0],16,static_cast<unsigned char>(0));
+         std::fill_n(lookup_[1],16,static_cast<unsigned char>(0));
+         delimiter_count_ = 0;
+         for (std::size_t c = 0; c < table_size; ++c)
+         {
+            if (!delimiter_table_[c])
+               continue;
+            lookup_[c >> 7][c & 0x0F] |= static_cast<unsigned char>(1 << ((c >> 4) & 7));
+            if (delimiter_count_ < max_compare_delimiters)
+               delimiter_list_[delimiter_count_] = static_cast<unsigned char>(c);
+            ++delimiter_count_;
+         }
       }
 
       bool delimiter_table_[table_size];
+      unsigned char lookup_[2][16];
+      unsigned char delimiter_list_[max_compare_delimiters];
+      std::size_t delimiter_count_;
    };
 
    namespace details
@@ -3201,6 +3416,111 @@ namespace strtk
       return token_count;
    }
 
+   #ifdef strtk_enable_sse2
+   namespace details
+   {
+      // Turns the delimiters multiple_char_delimiter_predicate::scan finds into tokens, the same
+      // ones split would have made going through a char at a time
+      template <typename Iterator, typename OutputIterator>
+      class block_splitter
+      {
+      public:
+
+         block_splitter(const Iterator begin, OutputIterator out, const bool compress_delimiters)
+         : token_begin_(begin),
+           run_end_(0),
+           out_(out),
+           compress_delimiters_(compress_delimiters),
+           token_count_(0)
+         {}
+
+         inline void operator()(const unsigned char* delimiter)
+         {
+            const Iterator itr = reinterpret_cast<Iterator>(delimiter);
+            if (!compress_delimiters_ || (itr != run_end_))
+            {
+               (*out_) = std::make_pair(token_begin_,itr);
+               ++out_;
+               ++token_count_;
+            }
+            token_begin_ = itr + 1;
+            run_end_     = itr + 1;
+         }
+
+         inline std::size_t finish(const Iterator end, const bool ends_with_delimiter)
+         {
+            if ((token_begin_ != end) || ends_with_delimiter)
+            {
+               (*out_) = std::make_pair(token_begin_,end);
+               ++out_;
+               ++token_count_;
+            }
+            return token_count_;
+         }
+
+      private:
+
+         Iterator token_begin_;
+         Iterator run_end_;
+         OutputIterator out_;
+         bool compress_delimiters_;
+         std::size_t token_count_;
+      };
+
+      template <typename Iterator, typename OutputIterator>
+      inline std::size_t split_blocks(const multiple_char_delimiter_predicate& delimiter,
+                                      const Iterator begin,
+                                      const Iterator end,
+                                      OutputIterator out,
+                                      const split_options::type split_option)
+      {
+         block_splitter<Iterator,OutputIterator> splitter(begin,out,split_options::perform_compress_delimiters(split_option));
+         const unsigned char* data_end = reinterpret_cast<const unsigned char*>(end);
+         const unsigned char* itr = delimiter.scan(reinterpret_cast<const unsigned char*>(begin),data_end,splitter);
+         for (; data_end != itr; ++itr)
+         {
+            if (delimiter(*itr))
+               splitter(itr);
+         }
+         return splitter.finish(end,delimiter(*(end - 1)));
+      }
+   }
+
+   // multiple_char_delimiter_predicate over contiguous chars finds its delimiters a block at a time,
+   // unless the delimiters have to go into the tokens too
+   template <typename OutputIterator>
+   inline std::size_t split(const multiple_char_delimiter_predicate& delimiter,
+                            const char* begin,
+                            const char* end,
+                            OutputIterator out,
+                            const split_options::type split_option = split_options::default_mode)
+   {
+      if (begin == end)
+         return 0;
+      else if (split_options::perform_include_1st_delimiter(split_option) ||
+               split_options::perform_include_all_delimiters(split_option))
+         return split<multiple_char_delimiter_predicate,const char*,OutputIterator>(delimiter,begin,end,out,split_option);
+      else
+         return details::split_blocks(delimiter,begin,end,out,split_option);
+   }
+
+   template <typename OutputIterator>
+   inline std::size_t split(const multiple_char_delimiter_predicate& delimiter,
+                            const unsigned char* begin,
+                            const unsigned char* end,
+                            OutputIterator out,
+                            const split_options::type split_option = split_options::default_mode)
+   {
+      if (begin == end)
+         return 0;
+      else if (split_options::perform_include_1st_delimiter(split_option) ||
+               split_options::perform_include_all_delimiters(split_option))
+         return split<multiple_char_delimiter_predicate,const unsigned char*,OutputIterator>(delimiter,begin,end,out,split_option);
+      else
+         return details::split_blocks(delimiter,begin,end,out,split_option);
+   }
+   #endif
+
    template <typename DelimiterPredicate,
              typename Iterator,
              typename OutputIterator>
@@ -4957,132 +5277,442 @@ namespace strtk
       typedef const unsigned char* iterator_t;
       typedef unsigned int index_t;
       typedef std::pair<iterator_t,iterator_t> range_t;
-      typedef std::deque<range_t> token_list_t;
-      typedef std::pair<index_t,index_t> row_index_range_t;
-      typedef std::deque<row_index_range_t> row_index_t;
-      typedef std::pair<index_t,index_t> row_range_t;
-      typedef std::pair<index_t,index_t> col_range_t;
 
-   private:
-
-      struct store
+      // The tokens of a grid, in order. For a buffer under 4GB every token is kept as a pair of 32-bit
+      // offsets from the start of the buffer, half the size of a pair of pointers, in one contiguous
+      // block so going along a row is plain indexing. Bigger buffers (or tokens added before reset()
+      // says where the buffer is) keep the deque of pointers. Either way tokens come back out as ranges,
+      // and the iterators hand out a stand-in for the range where a deque would have handed out a reference.
+      class token_index
       {
-         store()
-         : max_column(0)
-         {}
+      public:
 
-         token_list_t token_list;
-         row_index_t   row_index;
-         std::size_t  max_column;
+         typedef range_t value_type;
+         typedef const range_t& const_reference;
+         typedef std::pair<index_t,index_t> offset_t;
 
-         inline void clear()
+         class token_reference
          {
-            token_list.clear();
-            row_index.clear();
-         }
+         public:
 
-         inline range_t operator()(const std::size_t& col, const std::size_t& row) const
-         {
-            if (row < row_index.size())
-            {
-               const row_index_range_t& r = row_index[row];
-               if (col < (r.second - r.first + 1))
-                  return *(token_list.begin() + (r.first + col));
-               else
-                  return null_range();
-            }
-            else
-               return null_range();
-         }
+            token_reference(token_index& index, const std::size_t& position)
+            : index_(&index),
+              position_(position)
+            {}
 
-         inline bool remove_row(const std::size_t& row)
-         {
-            if (row >= row_index.size()) return false;
-            row_index_range_t& r = row_index[row];
-            std::size_t number_of_tokens = r.second - r.first + 1;
-            token_list_t::iterator remove_begin = token_list.begin() + r.first;
-            token_list_t::iterator remove_end = token_list.begin() + r.first + number_of_tokens;
-            token_list.erase(remove_begin,remove_end);
-            row_index.erase(row_index.begin() + row);
-            for (std::size_t i = row; i < row_index.size(); ++i)
+            inline operator range_t() const
             {
-               row_index_range_t& r = row_index[i];
-               r.first  -= static_cast<unsigned int>(number_of_tokens);
-               r.second -= static_cast<unsigned int>(number_of_tokens);
+               return index_->at(position_);
             }
-            return true;
-         }
-
-         inline std::size_t token_count(const row_index_range_t& r) const
-         {
-            return (r.second - r.first + 1);
-         }
-
-         inline std::size_t token_count(const std::size_t& index) const
-         {
-            return token_count(row_index[index]);
-         }
 
-         inline bool remove_row_range(const std::size_t& r0, const std::size_t& r1)
-         {
-            if (r0 > r1)
-               return false;
-            else if (r0 >= row_index.size())
-               return false;
-            else if (r1 >= row_index.size())
-               return false;
-            std::size_t number_of_tokens = 0;
-            for (std::size_t i = r0; i <= r1; ++i)
+            inline token_reference& operator=(const range_t& range)
             {
-               row_index_range_t& r = row_index[i];
-               number_of_tokens += token_count(r);
+               index_->set(position_,range);
+               return *this;
             }
-            row_index_range_t rr0 = row_index[r0];
-            token_list_t::iterator remove_begin = token_list.begin() + rr0.first;
-            token_list_t::iterator remove_end = token_list.begin() + rr0.first + number_of_tokens;
-            token_list.erase(remove_begin,remove_end);
-            row_index.erase(row_index.begin() + r0,row_index.begin() + r0 + (r1 - r0 + 1));
-            for (std::size_t i = r0; i < row_index.size(); ++i)
+
+            inline token_reference& operator=(const token_reference& reference)
             {
-               row_index_range_t& r = row_index[i];
-               r.first  -= static_cast<unsigned int>(number_of_tokens);
-               r.second -= static_cast<unsigned int>(number_of_tokens);
+               index_->set(position_,reference.index_->at(reference.position_));
+               return *this;
             }
-            return true;
-         }
 
-         struct remove_column_impl
+         private:
+
+            token_index* index_;
+            std::size_t position_;
+         };
+
+         template <typename Index, typename Reference>
+         class iterator_base
          {
-            std::size_t column;
-            std::size_t counter;
-            std::size_t remainder;
-            std::size_t current_row;
+         public:
 
-            inline void update(store& idx)
+            typedef std::random_access_iterator_tag iterator_category;
+            typedef range_t value_type;
+            typedef std::ptrdiff_t difference_type;
+            typedef const range_t* pointer;
+            typedef Reference reference;
+
+            // So that itr->first works without a range to point at
+            struct arrow
             {
-               current_row++;
-               while (current_row < idx.row_index.size())
-               {
-                  std::size_t number_of_tokens = idx.token_count(current_row);
-                  if (number_of_tokens > column)
-                     break;
-                  counter += number_of_tokens;
-                  ++current_row;
-               }
-               if (current_row < idx.row_index.size())
+               range_t range;
+
+               inline const range_t* operator->() const
                {
-                  counter += column + remainder;
-                  row_index_range_t& r = idx.row_index[current_row];
-                  remainder = (r.second - r.first) - column;
+                  return &range;
                }
-               else
-                  counter = std::numeric_limits<std::size_t>::max();
+            };
+
+            iterator_base()
+            : index_(0),
+              position_(0)
+            {}
+
+            iterator_base(Index* index, const std::size_t& position)
+            : index_(index),
+              position_(position)
+            {}
+
+            template <typename OtherIndex, typename OtherReference>
+            iterator_base(const iterator_base<OtherIndex,OtherReference>& itr)
+            : index_(itr.container()),
+              position_(itr.position())
+            {}
+
+            inline Index* container() const
+            {
+               return index_;
             }
 
-            inline void process(store& idx)
+            inline std::size_t position() const
             {
-               token_list_t::iterator itr1 = idx.token_list.begin();
-               token_list_t::iterator itr2 = idx.token_list.begin();
+               return position_;
+            }
+
+            inline Reference operator*() const
+            {
+               return index_->token(position_);
+            }
+
+            inline arrow operator->() const
+            {
+               arrow a;
+               a.range = index_->at(position_);
+               return a;
+            }
+
+            inline Reference operator[](const difference_type& n) const
+            {
+               return index_->token(position_ + n);
+            }
+
+            inline iterator_base& operator++()    { ++position_; return *this; }
+            inline iterator_base& operator--()    { --position_; return *this; }
+            inline iterator_base  operator++(int) { iterator_base itr = *this; ++position_; return itr; }
+            inline iterator_base  operator--(int) { iterator_base itr = *this; --position_; return itr; }
+
+            inline iterator_base& operator+=(const difference_type& n) { position_ += n; return *this; }
+            inline iterator_base& operator-=(const difference_type& n) { position_ -= n; return *this; }
+
+            inline iterator_base operator+(const difference_type& n) const { return iterator_base(index_,position_ + n); }
+            inline iterator_base operator-(const difference_type& n) const { return iterator_base(index_,position_ - n); }
+
+            inline difference_type operator-(const iterator_base& itr) const
+            {
+               return static_cast<difference_type>(position_) - static_cast<difference_type>(itr.position_);
+            }
+
+            inline bool operator==(const iterator_base& itr) const { return position_ == itr.position_; }
+            inline bool operator!=(const iterator_base& itr) const { return position_ != itr.position_; }
+            inline bool operator< (const iterator_base& itr) const { return position_ <  itr.position_; }
+            inline bool operator> (const iterator_base& itr) const { return position_ >  itr.position_; }
+            inline bool operator<=(const iterator_base& itr) const { return position_ <= itr.position_; }
+            inline bool operator>=(const iterator_base& itr) const { return position_ >= itr.position_; }
+
+         private:
+
+            Index* index_;
+            std::size_t position_;
+         };
+
+         typedef iterator_base<token_index,token_reference> iterator;
+         typedef iterator_base<const token_index,range_t> const_iterator;
+
+         token_index()
+         : base_(0),
+           compact_(false),
+           view_(0),
+           view_size_(0)
+         {}
+
+         // Starts over for tokens from the buffer [begin,end)
+         inline void reset(iterator_t begin, iterator_t end)
+         {
+            clear();
+            base_ = begin;
+            compact_ = (static_cast<std::size_t>(end - begin) <= static_cast<std::size_t>(std::numeric_limits<index_t>::max()));
+         }
+
+         inline bool compact() const
+         {
+            return compact_;
+         }
+
+         // Takes its offsets from somewhere else (like a mapped index file) rather than keeping a copy,
+         // until something gets changed. Only for a compact index, after reset().
+         inline void view(const offset_t* offsets, const std::size_t& count)
+         {
+            clear();
+            view_ = offsets;
+            view_size_ = count;
+         }
+
+         // All the offsets in a row, for a compact index
+         inline const offset_t* offsets() const
+         {
+            if (0 != view_)
+               return view_;
+            else
+               return narrow_.empty() ? 0 : &narrow_[0];
+         }
+
+         inline std::size_t size() const
+         {
+            if (compact_)
+               return (0 != view_) ? view_size_ : narrow_.size();
+            else
+               return wide_.size();
+         }
+
+         inline bool empty() const
+         {
+            return (0 == size());
+         }
+
+         // Bytes each token takes up in the index
+         inline std::size_t token_size() const
+         {
+            return compact_ ? sizeof(offset_t) : sizeof(range_t);
+         }
+
+         inline range_t at(const std::size_t& position) const
+         {
+            if (compact_)
+            {
+               const offset_t& offset = (0 != view_) ? view_[position] : narrow_[position];
+               return range_t(base_ + offset.first,base_ + offset.second);
+            }
+            else
+               return wide_[position];
+         }
+
+         inline void set(const std::size_t& position, const range_t& range)
+         {
+            if (compact_)
+            {
+               own();
+               narrow_[position] = to_offset(range);
+            }
+            else
+               wide_[position] = range;
+         }
+
+         inline range_t operator[](const std::size_t& position) const
+         {
+            return at(position);
+         }
+
+         inline range_t token(const std::size_t& position) const
+         {
+            return at(position);
+         }
+
+         inline token_reference token(const std::size_t& position)
+         {
+            return token_reference(*this,position);
+         }
+
+         inline void push_back(const range_t& range)
+         {
+            if (compact_)
+            {
+               own();
+               narrow_.push_back(to_offset(range));
+            }
+            else
+               wide_.push_back(range);
+         }
+
+         inline void clear()
+         {
+            wide_.clear();
+            narrow_.clear();
+            view_ = 0;
+            view_size_ = 0;
+         }
+
+         inline void resize(const std::size_t& n)
+         {
+            if (compact_)
+            {
+               own();
+               narrow_.resize(n);
+            }
+            else
+               wide_.resize(n);
+         }
+
+         inline void erase(iterator begin, iterator end)
+         {
+            if (compact_)
+            {
+               own();
+               narrow_.erase(narrow_.begin() + begin.position(),narrow_.begin() + end.position());
+            }
+            else
+               wide_.erase(wide_.begin() + begin.position(),wide_.begin() + end.position());
+         }
+
+         inline iterator begin()             { return iterator(this,0);            }
+         inline iterator end()               { return iterator(this,size());       }
+         inline const_iterator begin() const { return const_iterator(this,0);      }
+         inline const_iterator end() const   { return const_iterator(this,size()); }
+
+      private:
+
+         // Copy the offsets being viewed before changing any of them
+         inline void own()
+         {
+            if (0 != view_)
+            {
+               narrow_.assign(view_,view_ + view_size_);
+               view_ = 0;
+               view_size_ = 0;
+            }
+         }
+
+         inline offset_t to_offset(const range_t& range) const
+         {
+            return offset_t(static_cast<index_t>(range.first  - base_),
+                            static_cast<index_t>(range.second - base_));
+         }
+
+         std::deque<range_t> wide_;
+         std::vector<offset_t> narrow_;
+         iterator_t base_;
+         bool compact_;
+         const offset_t* view_;
+         std::size_t view_size_;
+      };
+
+      typedef token_index token_list_t;
+      typedef std::pair<index_t,index_t> row_index_range_t;
+      typedef std::deque<row_index_range_t> row_index_t;
+      typedef std::pair<index_t,index_t> row_range_t;
+      typedef std::pair<index_t,index_t> col_range_t;
+
+   private:
+
+      struct store
+      {
+         store()
+         : max_column(0)
+         {}
+
+         token_list_t token_list;
+         row_index_t   row_index;
+         std::size_t  max_column;
+
+         inline void clear()
+         {
+            token_list.clear();
+            row_index.clear();
+         }
+
+         inline range_t operator()(const std::size_t& col, const std::size_t& row) const
+         {
+            if (row < row_index.size())
+            {
+               const row_index_range_t& r = row_index[row];
+               if (col < (r.second - r.first + 1))
+                  return *(token_list.begin() + (r.first + col));
+               else
+                  return null_range();
+            }
+            else
+               return null_range();
+         }
+
+         inline bool remove_row(const std::size_t& row)
+         {
+            if (row >= row_index.size()) return false;
+            row_index_range_t& r = row_index[row];
+            std::size_t number_of_tokens = r.second - r.first + 1;
+            token_list_t::iterator remove_begin = token_list.begin() + r.first;
+            token_list_t::iterator remove_end = token_list.begin() + r.first + number_of_tokens;
+            token_list.erase(remove_begin,remove_end);
+            row_index.erase(row_index.begin() + row);
+            for (std::size_t i = row; i < row_index.size(); ++i)
+            {
+               row_index_range_t& r = row_index[i];
+               r.first  -= static_cast<unsigned int>(number_of_tokens);
+               r.second -= static_cast<unsigned int>(number_of_tokens);
+            }
+            return true;
+         }
+
+         inline std::size_t token_count(const row_index_range_t& r) const
+         {
+            return (r.second - r.first + 1);
+         }
+
+         inline std::size_t token_count(const std::size_t& index) const
+         {
+            return token_count(row_index[index]);
+         }
+
+         inline bool remove_row_range(const std::size_t& r0, const std::size_t& r1)
+         {
+            if (r0 > r1)
+               return false;
+            else if (r0 >= row_index.size())
+               return false;
+            else if (r1 >= row_index.size())
+               return false;
+            std::size_t number_of_tokens = 0;
+            for (std::size_t i = r0; i <= r1; ++i)
+            {
+               row_index_range_t& r = row_index[i];
+               number_of_tokens += token_count(r);
+            }
+            row_index_range_t rr0 = row_index[r0];
+            token_list_t::iterator remove_begin = token_list.begin() + rr0.first;
+            token_list_t::iterator remove_end = token_list.begin() + rr0.first + number_of_tokens;
+            token_list.erase(remove_begin,remove_end);
+            row_index.erase(row_index.begin() + r0,row_index.begin() + r0 + (r1 - r0 + 1));
+            for (std::size_t i = r0; i < row_index.size(); ++i)
+            {
+               row_index_range_t& r = row_index[i];
+               r.first  -= static_cast<unsigned int>(number_of_tokens);
+               r.second -= static_cast<unsigned int>(number_of_tokens);
+            }
+            return true;
+         }
+
+         struct remove_column_impl
+         {
+            std::size_t column;
+            std::size_t counter;
+            std::size_t remainder;
+            std::size_t current_row;
+
+            inline void update(store& idx)
+            {
+               current_row++;
+               while (current_row < idx.row_index.size())
+               {
+                  std::size_t number_of_tokens = idx.token_count(current_row);
+                  if (number_of_tokens > column)
+                     break;
+                  counter += number_of_tokens;
+                  ++current_row;
+               }
+               if (current_row < idx.row_index.size())
+               {
+                  counter += column + remainder;
+                  row_index_range_t& r = idx.row_index[current_row];
+                  remainder = (r.second - r.first) - column;
+               }
+               else
+                  counter = std::numeric_limits<std::size_t>::max();
+            }
+
+            inline void process(store& idx)
+            {
+               token_list_t::iterator itr1 = idx.token_list.begin();
+               token_list_t::iterator itr2 = idx.token_list.begin();
                token_list_t::iterator end  = idx.token_list.end();
                counter = 0;
                remainder = 0;
@@ -5163,6 +5793,7 @@ namespace strtk
          {
             if (0 == std::distance(range.first,range.second))
                return;
+            reset_predicate(token_predicate_);
             row_start_index_ = idx_.token_list.size();
             std::size_t token_count = split(token_predicate_,
                                             range.first,range.second,
@@ -5210,7 +5841,10 @@ namespace strtk
            column_split_option(split_options::compress_delimiters),
            row_delimiters("\n\r"),
            column_delimiters(",|;\t "),
-           support_dquotes(false)
+           support_dquotes(false),
+           memory_map(false),
+           parallel_index(false),
+           index_file(false)
          {}
 
          options(split_options::type sro,
@@ -5222,7 +5856,10 @@ namespace strtk
            column_split_option(sco),
            row_delimiters(rd),
            column_delimiters(cd),
-           support_dquotes(support_dq)
+           support_dquotes(support_dq),
+           memory_map(false),
+           parallel_index(false),
+           index_file(false)
          {}
 
          inline options& set_column_split_option(const split_options::type& option)
@@ -5249,11 +5886,32 @@ namespace strtk
             return *this;
          }
 
+         inline options& set_memory_map(const bool map)
+         {
+            memory_map = map;
+            return *this;
+         }
+
+         inline options& set_parallel_index(const bool parallel)
+         {
+            parallel_index = parallel;
+            return *this;
+         }
+
+         inline options& set_index_file(const bool keep_index)
+         {
+            index_file = keep_index;
+            return *this;
+         }
+
          split_options::type row_split_option;
          split_options::type column_split_option;
          std::string row_delimiters;
          std::string column_delimiters;
          bool support_dquotes;
+         bool memory_map; // map the file straight into memory (copy-on-write) rather than reading it into a new buffer
+         bool parallel_index; // index big buffers a chunk of rows per thread (only when built with OpenMP)
+         bool index_file; // keep the index of a file next to it (as file_name.idx) and reuse it while the file's unchanged
       };
 
       class row_type
@@ -5968,6 +6626,404 @@ namespace strtk
          token_list_t::const_iterator begin_;
       };
 
+      // Goes through a file a row at a time, for files too big to load whole. The file's read into a
+      // fixed size window, and every whole row in it gets indexed in one go. Once those are used up, what's
+      // left of the row that ran off the end is moved to the front and the window's topped up after it.
+      // Only the tokens for the rows in the window are kept, and row() gives the same row_type a token_grid
+      // would, good until the next call to next(). A row longer than the whole window makes it grow to fit.
+      //
+      //    strtk::token_grid::row_cursor cursor("game_logs.csv");
+      //    while (cursor.next())
+      //    {
+      //       total += cursor.row().get<int>(3);
+      //    }
+      class row_cursor
+      {
+      public:
+
+         row_cursor(const std::string& file_name,
+                    const token_grid::options& options = token_grid::options(),
+                    const std::size_t window_size = one_megabyte)
+         : stream_(file_name.c_str(),std::ios::binary),
+           open_(stream_.is_open()),
+           window_(std::max<std::size_t>(window_size,1)),
+           data_begin_(0),
+           data_end_(0),
+           row_(0),
+           row_count_(0),
+           options_(options),
+           row_predicate_(options.row_delimiters)
+         {}
+
+         // False once there are no rows left
+         inline bool next()
+         {
+            ++row_;
+            while (row_ >= current_.row_index.size())
+            {
+               if (!index_window())
+                  return false;
+            }
+            ++row_count_;
+            return true;
+         }
+
+         inline row_type row() const
+         {
+            return row_type(row_,current_);
+         }
+
+         // Rows gone through so far, counting the current one
+         inline std::size_t row_count() const
+         {
+            return row_count_;
+         }
+
+         inline std::size_t window_size() const
+         {
+            return window_.size();
+         }
+
+         inline bool operator!() const
+         {
+            return !open_;
+         }
+
+      private:
+
+         row_cursor(const row_cursor&);
+         row_cursor& operator=(const row_cursor&);
+
+         inline const unsigned char* window_data() const
+         {
+            return &window_[0];
+         }
+
+         // Indexes the whole rows in the window, topping it up first if there aren't any.
+         // False once the file's done with.
+         inline bool index_window()
+         {
+            current_.clear();
+            row_ = 0;
+            for ( ; ; )
+            {
+               const unsigned char* begin    = window_data() + data_begin_;
+               const unsigned char* end      = window_data() + data_end_;
+               const unsigned char* rows_end = after_last_row_delimiter(begin,end);
+
+               if (begin != rows_end)
+                  return use_rows(begin,rows_end);
+               else if (refill())
+                  continue;
+               else if (data_begin_ != data_end_)
+               {
+                  // The last row, without a row delimiter after it (refill may have moved it)
+                  return use_rows(window_data() + data_begin_,window_data() + data_end_);
+               }
+               else
+                  return false;
+            }
+         }
+
+         inline bool use_rows(const unsigned char* begin, const unsigned char* end)
+         {
+            current_.token_list.reset(begin,end);
+            index_rows(options_,begin,end,current_);
+            data_begin_ += static_cast<std::size_t>(end - begin);
+            return true;
+         }
+
+         // Moves what's left to the front of the window and reads as much as fits after it, growing
+         // the window if it's already full of one row. False if there's nothing more to read.
+         inline bool refill()
+         {
+            if (!stream_)
+               return false;
+            const std::size_t left = data_end_ - data_begin_;
+            if (0 != data_begin_)
+               std::copy(window_.begin() + data_begin_,window_.begin() + data_end_,window_.begin());
+            else if (left == window_.size())
+               window_.resize(2 * window_.size());
+            data_begin_ = 0;
+            data_end_   = left;
+            stream_.read(reinterpret_cast<char*>(&window_[data_end_]),static_cast<std::streamsize>(window_.size() - data_end_));
+            data_end_ += static_cast<std::size_t>(stream_.gcount());
+            return (left != data_end_);
+         }
+
+         // Where the whole rows stop, or begin if there's no row delimiter at all
+         inline const unsigned char* after_last_row_delimiter(const unsigned char* begin, const unsigned char* end) const
+         {
+            while ((begin != end) && !row_predicate_(*(end - 1))) --end;
+            return end;
+         }
+
+         std::ifstream stream_;
+         bool open_;
+         std::vector<unsigned char> window_;
+         std::size_t data_begin_;
+         std::size_t data_end_;
+         std::size_t row_;
+         std::size_t row_count_;
+         token_grid::options options_;
+         multiple_char_delimiter_predicate row_predicate_;
+         store current_;
+      };
+
+      // Which columns to_columns pulls out of a grid and what each one becomes. Columns are picked by
+      // number or by their name in the header row (the first row, matched ignoring case), and come
+      // out in the order they're added.
+      //
+      //    strtk::token_grid::column_schema schema;
+      //    schema.add_string("player").add_int("gp").add_double("pts");
+      class column_schema
+      {
+      public:
+
+         enum column_type
+         {
+            int_type,
+            float_type,
+            double_type,
+            string_type
+         };
+
+         struct column
+         {
+            std::string name; // empty when picked by number
+            std::size_t index;
+            column_type type;
+         };
+
+         column_schema()
+         : header_row_(true)
+         {}
+
+         inline column_schema& add_int   (const std::string& name) { return add(name,0,int_type);    }
+         inline column_schema& add_float (const std::string& name) { return add(name,0,float_type);  }
+         inline column_schema& add_double(const std::string& name) { return add(name,0,double_type); }
+         inline column_schema& add_string(const std::string& name) { return add(name,0,string_type); }
+
+         inline column_schema& add_int   (const std::size_t& index) { return add("",index,int_type);    }
+         inline column_schema& add_float (const std::size_t& index) { return add("",index,float_type);  }
+         inline column_schema& add_double(const std::size_t& index) { return add("",index,double_type); }
+         inline column_schema& add_string(const std::size_t& index) { return add("",index,string_type); }
+
+         // Whether the first row is names rather than data (it is unless told otherwise)
+         inline column_schema& set_header_row(const bool header_row)
+         {
+            header_row_ = header_row;
+            return *this;
+         }
+
+         inline bool header_row() const
+         {
+            return header_row_;
+         }
+
+         inline std::size_t size() const
+         {
+            return column_list_.size();
+         }
+
+         inline const column& operator[](const std::size_t& index) const
+         {
+            return column_list_[index];
+         }
+
+      private:
+
+         inline column_schema& add(const std::string& name, const std::size_t& index, const column_type type)
+         {
+            column c;
+            c.name  = name;
+            c.index = index;
+            c.type  = type;
+            column_list_.push_back(c);
+            return *this;
+         }
+
+         std::vector<column> column_list_;
+         bool header_row_;
+      };
+
+      // Columns from to_columns, each one a plain array with a value for every row, so anything
+      // going down a column runs over contiguous memory rather than back through the tokens. Strings
+      // are interned into one pool for the whole table, with id 0 always the empty string. Empty
+      // tokens and rows too short to have the column are null, tokens that don't convert are errors,
+      // and either way the value is left as zero (or id 0).
+      class column_table
+      {
+      public:
+
+         column_table()
+         : row_count_(0)
+         {
+            clear();
+         }
+
+         inline void clear()
+         {
+            column_list_.clear();
+            row_count_ = 0;
+            string_list_.assign(1,std::string());
+            string_id_map_.clear();
+            string_id_map_[std::string()] = 0;
+         }
+
+         inline std::size_t row_count() const
+         {
+            return row_count_;
+         }
+
+         inline std::size_t column_count() const
+         {
+            return column_list_.size();
+         }
+
+         // Which column of the grid a column came from
+         inline std::size_t grid_column(const std::size_t& column) const
+         {
+            return column_list_[column].grid_column;
+         }
+
+         inline column_schema::column_type type(const std::size_t& column) const
+         {
+            return column_list_[column].type;
+         }
+
+         // Each of these is empty unless the column is of that type
+         inline const std::vector<int>&          ints      (const std::size_t& column) const { return column_list_[column].ints;    }
+         inline const std::vector<float>&        floats    (const std::size_t& column) const { return column_list_[column].floats;  }
+         inline const std::vector<double>&       doubles   (const std::size_t& column) const { return column_list_[column].doubles; }
+         inline const std::vector<unsigned int>& string_ids(const std::size_t& column) const { return column_list_[column].ids;     }
+
+         inline const std::vector<bool>& nulls(const std::size_t& column) const
+         {
+            return column_list_[column].nulls;
+         }
+
+         inline const std::vector<bool>& errors(const std::size_t& column) const
+         {
+            return column_list_[column].errors;
+         }
+
+         inline bool is_null(const std::size_t& column, const std::size_t& row) const
+         {
+            return column_list_[column].nulls[row];
+         }
+
+         inline bool is_error(const std::size_t& column, const std::size_t& row) const
+         {
+            return column_list_[column].errors[row];
+         }
+
+         inline bool is_valid(const std::size_t& column, const std::size_t& row) const
+         {
+            return !is_null(column,row) && !is_error(column,row);
+         }
+
+         inline const std::string& string(const unsigned int& id) const
+         {
+            return string_list_[id];
+         }
+
+         inline std::size_t string_count() const
+         {
+            return string_list_.size();
+         }
+
+         // Id of a string already in the table, or string_count() if it isn't
+         inline unsigned int string_id(const std::string& s) const
+         {
+            std::map<std::string,unsigned int>::const_iterator itr = string_id_map_.find(s);
+            return (string_id_map_.end() != itr) ? itr->second : static_cast<unsigned int>(string_list_.size());
+         }
+
+      private:
+
+         friend class token_grid;
+
+         struct column_data
+         {
+            column_schema::column_type type;
+            std::size_t grid_column;
+            std::vector<int> ints;
+            std::vector<float> floats;
+            std::vector<double> doubles;
+            std::vector<unsigned int> ids;
+            std::vector<bool> nulls;
+            std::vector<bool> errors;
+         };
+
+         inline void add_column(const column_schema::column_type type, const std::size_t& grid_column, const std::size_t& rows)
+         {
+            column_list_.push_back(column_data());
+            column_data& c = column_list_.back();
+            c.type = type;
+            c.grid_column = grid_column;
+            switch (type)
+            {
+               case column_schema::int_type    : c.ints.resize(rows,0);      break;
+               case column_schema::float_type  : c.floats.resize(rows,0.0f); break;
+               case column_schema::double_type : c.doubles.resize(rows,0.0); break;
+               case column_schema::string_type : c.ids.resize(rows,0);       break;
+            }
+            c.nulls.resize(rows,false);
+            c.errors.resize(rows,false);
+         }
+
+         inline void set(const std::size_t& column, const std::size_t& row, const range_t& range)
+         {
+            column_data& c = column_list_[column];
+            if (range.first == range.second)
+            {
+               c.nulls[row] = true;
+               return;
+            }
+            bool converted = true;
+            switch (c.type)
+            {
+               case column_schema::int_type    : converted = string_to_type_converter(range.first,range.second,c.ints[row]);    break;
+               case column_schema::float_type  : converted = string_to_type_converter(range.first,range.second,c.floats[row]);  break;
+               case column_schema::double_type : converted = string_to_type_converter(range.first,range.second,c.doubles[row]); break;
+               case column_schema::string_type : c.ids[row] = intern(range);                                                     break;
+            }
+            if (!converted)
+            {
+               c.errors[row] = true;
+               clear_value(c,row);
+            }
+         }
+
+         // A failed conversion may have left part of a number behind
+         static inline void clear_value(column_data& c, const std::size_t& row)
+         {
+            switch (c.type)
+            {
+               case column_schema::int_type    : c.ints[row]    = 0;    break;
+               case column_schema::float_type  : c.floats[row]  = 0.0f; break;
+               case column_schema::double_type : c.doubles[row] = 0.0;  break;
+               case column_schema::string_type : c.ids[row]     = 0;    break;
+            }
+         }
+
+         inline unsigned int intern(const range_t& range)
+         {
+            const std::string s(range.first,range.second);
+            std::pair<std::map<std::string,unsigned int>::iterator,bool> result =
+               string_id_map_.insert(std::make_pair(s,static_cast<unsigned int>(string_list_.size())));
+            if (result.second)
+               string_list_.push_back(s);
+            return result.first->second;
+         }
+
+         std::vector<column_data> column_list_;
+         std::size_t row_count_;
+         std::vector<std::string> string_list_;
+         std::map<std::string,unsigned int> string_id_map_;
+      };
+
       token_grid()
       : file_name_(""),
         buffer_(0),
@@ -5975,6 +7031,9 @@ namespace strtk
         min_column_count_(0),
         max_column_count_(0),
         load_from_file_(false),
+        mapped_(false),
+        index_map_(0),
+        index_map_size_(0),
         state_(false)
       {}
 
@@ -5987,6 +7046,9 @@ namespace strtk
         max_column_count_(0),
         options_(options),
         load_from_file_(true),
+        mapped_(false),
+        index_map_(0),
+        index_map_size_(0),
         state_(load())
       {}
 
@@ -6000,6 +7062,9 @@ namespace strtk
         max_column_count_(0),
         options_(options),
         load_from_file_(false),
+        mapped_(false),
+        index_map_(0),
+        index_map_size_(0),
         state_(load())
       {}
 
@@ -6013,6 +7078,9 @@ namespace strtk
         max_column_count_(0),
         options_(options),
         load_from_file_(false),
+        mapped_(false),
+        index_map_(0),
+        index_map_size_(0),
         state_(load())
       {}
 
@@ -6026,6 +7094,9 @@ namespace strtk
         max_column_count_(0),
         options_(options),
         load_from_file_(false),
+        mapped_(false),
+        index_map_(0),
+        index_map_size_(0),
         state_(load())
       {}
 
@@ -6042,6 +7113,9 @@ namespace strtk
                  row_delimiters,
                  column_delimiters),
         load_from_file_(true),
+        mapped_(false),
+        index_map_(0),
+        index_map_size_(0),
         state_(load())
       {}
 
@@ -6059,6 +7133,9 @@ namespace strtk
                  row_delimiters,
                  column_delimiters),
         load_from_file_(false),
+        mapped_(false),
+        index_map_(0),
+        index_map_size_(0),
         state_(load())
       {}
 
@@ -6076,6 +7153,9 @@ namespace strtk
                  row_delimiters,
                  column_delimiters),
         load_from_file_(false),
+        mapped_(false),
+        index_map_(0),
+        index_map_size_(0),
         state_(load())
       {}
 
@@ -6093,15 +7173,17 @@ namespace strtk
                  row_delimiters,
                  column_delimiters),
         load_from_file_(false),
+        mapped_(false),
+        index_map_(0),
+        index_map_size_(0),
         state_(load())
       {}
 
      ~token_grid()
       {
-         if ((load_from_file_) && (0 != buffer_))
+         if (load_from_file_)
          {
-            delete [] buffer_;
-            buffer_ = 0;
+            release_buffer();
          }
       }
 
@@ -6130,6 +7212,27 @@ namespace strtk
          return max_column_count_;
       }
 
+      // Bytes taken up by the token and row index (not counting the buffer itself or spare room in the containers)
+      inline std::size_t index_size() const
+      {
+         return (dsv_index_.token_list.size() * dsv_index_.token_list.token_size()) +
+                (dsv_index_.row_index.size()  * sizeof(row_index_range_t));
+      }
+
+      inline double index_bytes_per_token() const
+      {
+         if (dsv_index_.token_list.empty())
+            return 0.0;
+         else
+            return index_size() / static_cast<double>(dsv_index_.token_list.size());
+      }
+
+      // True when tokens are kept as 32-bit offsets into the buffer rather than pointers
+      inline bool compact_index() const
+      {
+         return dsv_index_.token_list.compact();
+      }
+
       inline range_t token(const unsigned int& row, const std::size_t& col) const
       {
          return dsv_index_(col,row);
@@ -6362,6 +7465,46 @@ namespace strtk
          return true;
       }
 
+      // Everything the schema asks for out of every row (but the header row), converted in a single
+      // pass over the rows. False, with table left empty, if a column named in the schema isn't in the header.
+      inline bool to_columns(const column_schema& schema, column_table& table) const
+      {
+         table.clear();
+
+         const std::size_t first_row = (schema.header_row() && !dsv_index_.row_index.empty()) ? 1 : 0;
+         const std::size_t rows = dsv_index_.row_index.size() - first_row;
+
+         std::vector<std::size_t> grid_column(schema.size(),0);
+         for (std::size_t c = 0; c < schema.size(); ++c)
+         {
+            const column_schema::column& column = schema[c];
+            if (column.name.empty())
+               grid_column[c] = column.index;
+            else if (!find_header_column(schema,column.name,grid_column[c]))
+            {
+               table.clear();
+               return false;
+            }
+            table.add_column(column.type,grid_column[c],rows);
+         }
+         table.row_count_ = rows;
+
+         for (std::size_t r = 0; r < rows; ++r)
+         {
+            const row_index_range_t& row = dsv_index_.row_index[first_row + r];
+            const std::size_t token_count = dsv_index_.token_count(row);
+            for (std::size_t c = 0; c < grid_column.size(); ++c)
+            {
+               if (grid_column[c] < token_count)
+                  table.set(c,r,dsv_index_.token_list[row.first + grid_column[c]]);
+               else
+                  table.column_list_[c].nulls[r] = true;
+            }
+         }
+
+         return true;
+      }
+
       inline void remove_row(const std::size_t& index)
       {
          if (index < dsv_index_.row_index.size())
@@ -6407,7 +7550,8 @@ namespace strtk
          }
          if (!remove_token_list.empty())
          {
-            remove_inplace(index_remover(remove_token_list),dsv_index_.token_list);
+            token_list_t& tokens = dsv_index_.token_list;
+            tokens.resize(tokens.size() - remove_inplace(index_remover(remove_token_list),tokens.begin(),tokens.end()));
          }
          return true;
       }
@@ -6458,7 +7602,8 @@ namespace strtk
          }
          if (!remove_token_list.empty())
          {
-            remove_inplace(index_remover(remove_token_list),dsv_index_.token_list);
+            token_list_t& tokens = dsv_index_.token_list;
+            tokens.resize(tokens.size() - remove_inplace(index_remover(remove_token_list),tokens.begin(),tokens.end()));
          }
          if (!remove_token_list.empty())
          {
@@ -6512,7 +7657,7 @@ namespace strtk
       inline void clear(const bool force_delete_buffer = false)
       {
          if (load_from_file_ || force_delete_buffer)
-            delete[] buffer_;
+            release_buffer();
          buffer_ = 0;
          buffer_size_ = 0;
          dsv_index_.clear();
@@ -6837,10 +7982,9 @@ namespace strtk
                 const token_grid::options& options)
       {
          file_name_ = file_name;
-         if ((load_from_file_) && (0 != buffer_))
+         if (load_from_file_)
          {
-            delete [] buffer_;
-            buffer_ = 0;
+            release_buffer();
          }
          buffer_size_ = 0;
          min_column_count_ = 0;
@@ -6853,10 +7997,9 @@ namespace strtk
          else
          {
             file_name_ = "";
-            if ((load_from_file_) && (0 != buffer_))
+            if (load_from_file_)
             {
-               delete [] buffer_;
-               buffer_ = 0;
+               release_buffer();
             }
             return false;
          }
@@ -6867,10 +8010,9 @@ namespace strtk
                 const token_grid::options& options)
       {
          file_name_ = "";
-         if ((load_from_file_) && (0 != buffer_))
+         if (load_from_file_)
          {
-            delete [] buffer_;
-            buffer_ = 0;
+            release_buffer();
          }
          min_column_count_ = 0;
          max_column_count_ = 0;
@@ -6884,10 +8026,9 @@ namespace strtk
          else
          {
             file_name_ = "";
-            if ((load_from_file_) && (0 != buffer_))
+            if (load_from_file_)
             {
-               delete [] buffer_;
-               buffer_ = 0;
+               release_buffer();
             }
             return false;
          }
@@ -6969,40 +8110,498 @@ namespace strtk
          mutable strtk::multiple_char_delimiter_predicate mdp_;
       };
 
+      // Rows are split on row delimiters whether or not they're in quotes, so a quote left open
+      // (or closing the row, which split looks at twice) mustn't carry over into the next row
+      template <typename Predicate>
+      static inline void reset_predicate(Predicate&)
+      {}
+
+      static inline void reset_predicate(double_quotes_predicate& predicate)
+      {
+         predicate.reset();
+      }
+
+      #ifdef strtk_enable_sse2
+      // Finds row delimiters, column delimiters and quotes a block at a time in one pass over the
+      // buffer, rather than splitting rows and then a char at a time through each row's columns.
+      // Whether a char is inside quotes is the prefix xor of the quotes up to it, started over at each
+      // row delimiter (rows end there regardless), and column delimiters inside quotes get dropped.
+      // The rows and tokens come out the same as splitting with double_quotes_predicate would give.
+      class structural_indexer
+      {
+      public:
+
+         typedef multiple_char_delimiter_predicate::block_classifier block_classifier;
+
+         structural_indexer(const options& opts, store& idx)
+         : row_predicate_(opts.row_delimiters),
+           column_predicate_(opts.column_delimiters),
+           quote_predicate_(std::string(1,'"')),
+           support_dquotes_(opts.support_dquotes),
+           compress_delimiters_(split_options::perform_compress_delimiters(opts.column_split_option)),
+           idx_(idx),
+           row_begin_(0),
+           token_begin_(0),
+           run_end_(0),
+           row_first_token_(0)
+         {
+            idx_.max_column = std::numeric_limits<std::size_t>::min();
+         }
+
+         inline void index(iterator_t begin, iterator_t end)
+         {
+            start_row(begin);
+            bool in_dquotes = false;
+
+            const block_classifier rows(row_predicate_);
+            const block_classifier columns(column_predicate_);
+            const block_classifier quotes(quote_predicate_);
+
+            if (rows.enabled() && columns.enabled())
+            {
+               const std::size_t size = block_classifier::size;
+               const unsigned int block = ~0U >> (32 - size);
+               unsigned int carry = 0;
+
+               for (; static_cast<std::size_t>(end - begin) >= size; begin += size)
+               {
+                  const unsigned int row_mask = rows(begin);
+                  unsigned int column_mask = columns(begin) & ~row_mask;
+
+                  if (support_dquotes_)
+                  {
+                     const unsigned int quote_mask = quotes(begin) & ~row_mask;
+                     unsigned int inside = prefix_xor(quote_mask) ^ carry;
+
+                     // A row delimiter closes any quote left open, so flip back everything after it
+                     for (unsigned int open = row_mask & inside; 0 != open; open = row_mask & inside)
+                     {
+                        inside ^= ~0U << block_classifier::first_set_bit(open);
+                     }
+
+                     inside &= block;
+                     carry  = (0 != (inside >> (size - 1))) ? block : 0;
+                     column_mask = quote_mask | (column_mask & ~inside);
+                  }
+
+                  for (unsigned int mask = row_mask | column_mask; 0 != mask; mask &= mask - 1)
+                  {
+                     const unsigned int bit = block_classifier::first_set_bit(mask);
+                     if (0 != (row_mask & (1U << bit)))
+                        next_row(begin + bit);
+                     else
+                        next_token(begin + bit);
+                  }
+               }
+
+               in_dquotes = (0 != carry);
+            }
+
+            for (; end != begin; ++begin)
+            {
+               const unsigned char c = *begin;
+               if (row_predicate_(c))
+               {
+                  next_row(begin);
+                  in_dquotes = false;
+               }
+               else if (support_dquotes_ && ('"' == c))
+               {
+                  in_dquotes = !in_dquotes;
+                  next_token(begin);
+               }
+               else if (!in_dquotes && column_predicate_(c))
+                  next_token(begin);
+            }
+
+            end_row(end);
+         }
+
+      private:
+
+         structural_indexer& operator=(const structural_indexer&);
+
+         static inline unsigned int prefix_xor(unsigned int mask)
+         {
+            #ifdef __PCLMUL__
+               // Carry-less multiply by all ones
+               const __m128i product = _mm_clmulepi64_si128(_mm_cvtsi32_si128(static_cast<int>(mask)),_mm_set1_epi8(-1),0);
+               return static_cast<unsigned int>(_mm_cvtsi128_si32(product));
+            #else
+               mask ^= mask << 1;
+               mask ^= mask << 2;
+               mask ^= mask << 4;
+               mask ^= mask << 8;
+               mask ^= mask << 16;
+               return mask;
+            #endif
+         }
+
+         inline void start_row(iterator_t begin)
+         {
+            row_begin_   = begin;
+            token_begin_ = begin;
+            run_end_     = 0;
+            row_first_token_ = idx_.token_list.size();
+         }
+
+         // Empty rows get skipped, and a row ending in a column delimiter gets an empty last token
+         inline void end_row(iterator_t end)
+         {
+            if (row_begin_ == end)
+               return;
+            if ((token_begin_ != end) || (run_end_ == end))
+               idx_.token_list.push_back(range_t(token_begin_,end));
+            const std::size_t token_count = idx_.token_list.size() - row_first_token_;
+            idx_.row_index.push_back(row_index_range_t(static_cast<index_t>(row_first_token_),
+                                                       static_cast<index_t>(row_first_token_ + token_count - 1)));
+            if (token_count > idx_.max_column)
+               idx_.max_column = token_count;
+         }
+
+         inline void next_row(iterator_t delimiter)
+         {
+            end_row(delimiter);
+            start_row(delimiter + 1);
+         }
+
+         inline void next_token(iterator_t delimiter)
+         {
+            if (!compress_delimiters_ || (delimiter != run_end_))
+               idx_.token_list.push_back(range_t(token_begin_,delimiter));
+            token_begin_ = delimiter + 1;
+            run_end_     = delimiter + 1;
+         }
+
+         multiple_char_delimiter_predicate row_predicate_;
+         multiple_char_delimiter_predicate column_predicate_;
+         multiple_char_delimiter_predicate quote_predicate_;
+         bool support_dquotes_;
+         bool compress_delimiters_;
+         store& idx_;
+         iterator_t row_begin_;
+         iterator_t token_begin_;
+         iterator_t run_end_;
+         std::size_t row_first_token_;
+      };
+      #endif
+
       inline bool load()
       {
          if (load_from_file_ && !load_buffer_from_file())
             return false;
 
-         dsv_index_.token_list.clear();
+         dsv_index_.token_list.reset(buffer_,buffer_ + buffer_size_);
          dsv_index_.row_index.clear();
 
-         multiple_char_delimiter_predicate text_newline_predicate(options_.row_delimiters);
+         // Only compact indexes get saved, as they're just offsets into the file
+         const bool use_index_file = load_from_file_ && options_.index_file && dsv_index_.token_list.compact();
+         index_file_header key;
+
+         if (use_index_file)
+         {
+            key = index_file_key();
+            if (load_index_file(key))
+            {
+               update_minmax_columns();
+               return true;
+            }
+         }
+
+         const std::size_t chunk_count = index_chunk_count();
+
+         if (chunk_count > 1)
+            index_chunks(chunk_count);
+         else
+            index_rows(options_, buffer_, buffer_ + buffer_size_, dsv_index_);
+
+         if (use_index_file)
+            save_index_file(key);
+
+         update_minmax_columns();
+         return true;
+      }
+
+      // An index file is a header, then the row index, then the token offsets, all as they are in memory.
+      // It's only used when the size, a hash of the contents and the options it was made with all match.
+      struct index_file_header
+      {
+         unsigned int magic;
+         unsigned int version;
+         unsigned int file_size;
+         unsigned int file_hash[2];
+         unsigned int options_hash;
+         unsigned int row_count;
+         unsigned int token_count;
+         unsigned int max_column;
+      };
+
+      enum
+      {
+         index_file_magic   = 0x49475453, // STGI
+         index_file_version = 1
+      };
+
+      inline std::string index_file_name() const
+      {
+         return file_name_ + ".idx";
+      }
+
+      inline index_file_header index_file_key() const
+      {
+         index_file_header key;
+         std::memset(&key,0,sizeof(key));
+         key.magic     = index_file_magic;
+         key.version   = index_file_version;
+         key.file_size = static_cast<unsigned int>(buffer_size_);
+         content_hash(buffer_,buffer_size_,key.file_hash);
+
+         std::string settings = options_.row_delimiters + '\0' + options_.column_delimiters + '\0';
+         settings += static_cast<char>(options_.row_split_option);
+         settings += static_cast<char>(options_.column_split_option);
+         settings += static_cast<char>(options_.support_dquotes ? 1 : 0);
+         unsigned int settings_hash[2];
+         content_hash(reinterpret_cast<const unsigned char*>(settings.data()),settings.size(),settings_hash);
+         key.options_hash = settings_hash[0];
+         return key;
+      }
+
+      // A quick 64-bit hash (as two halves) for telling whether a file's changed: four lanes of
+      // multiply and rotate, so it goes about as fast as the data can be read.
+      static inline void content_hash(const unsigned char* data, std::size_t size, unsigned int hash[2])
+      {
+         unsigned int lane[4] = { 0x9E3779B1U, 0x85EBCA77U, 0xC2B2AE3DU, 0x27D4EB2FU };
+         const std::size_t length = size;
+
+         for ( ; size >= 16; data += 16, size -= 16)
+         {
+            for (std::size_t i = 0; i < 4; ++i)
+            {
+               unsigned int word;
+               std::memcpy(&word,data + 4 * i,sizeof(word));
+               lane[i] = (lane[i] ^ word) * 0x9E3779B1U;
+               lane[i] = (lane[i] << 13) | (lane[i] >> 19);
+            }
+         }
+
+         for (std::size_t i = 0; i < size; ++i)
+         {
+            lane[i & 3] = (lane[i & 3] ^ data[i]) * 0x85EBCA77U;
+         }
+
+         unsigned int h0 = lane[0] ^ ((lane[1] << 7) | (lane[1] >> 25)) ^ static_cast<unsigned int>(length);
+         unsigned int h1 = lane[2] ^ ((lane[3] << 7) | (lane[3] >> 25)) ^ static_cast<unsigned int>(length);
+         h0 ^= h1 >> 15; h0 *= 0x85EBCA77U; h0 ^= h0 >> 13; h0 *= 0xC2B2AE3DU; h0 ^= h0 >> 16;
+         h1 ^= h0 >> 16; h1 *= 0xC2B2AE3DU; h1 ^= h1 >> 13; h1 *= 0x85EBCA77U; h1 ^= h1 >> 16;
+         hash[0] = h0;
+         hash[1] = h1;
+      }
+
+      // Maps the index file for this file if it's there and still matches, rather than indexing again
+      inline bool load_index_file(const index_file_header& key)
+      {
+         std::size_t size = 0;
+         void* view = map_file(index_file_name(),false,size);
+         if (0 == view)
+            return false;
+
+         const index_file_header& header = *reinterpret_cast<const index_file_header*>(view);
+         const row_index_range_t* rows = reinterpret_cast<const row_index_range_t*>(&header + 1);
+
+         bool valid = (size >= sizeof(header))                &&
+                      (header.magic        == key.magic)        &&
+                      (header.version      == key.version)      &&
+                      (header.file_size    == key.file_size)    &&
+                      (header.file_hash[0] == key.file_hash[0]) &&
+                      (header.file_hash[1] == key.file_hash[1]) &&
+                      (header.options_hash == key.options_hash) &&
+                      (size == sizeof(header) + header.row_count   * sizeof(row_index_range_t)
+                                              + header.token_count * sizeof(token_index::offset_t));
+
+         // Every row has to stay inside the tokens
+         for (std::size_t i = 0; valid && (i < header.row_count); ++i)
+         {
+            valid = (rows[i].first <= rows[i].second) && (rows[i].second < header.token_count);
+         }
+
+         // and every token inside the file, each one after the last, as they get handed out as is
+         const token_index::offset_t* offsets = reinterpret_cast<const token_index::offset_t*>(rows + header.row_count);
+         index_t last_end = 0;
+         for (std::size_t i = 0; valid && (i < header.token_count); ++i)
+         {
+            valid = (last_end <= offsets[i].first) && (offsets[i].first <= offsets[i].second) && (offsets[i].second <= header.file_size);
+            last_end = offsets[i].second;
+         }
+
+         if (!valid)
+         {
+            unmap_file(view,size);
+            return false;
+         }
+
+         index_map_      = view;
+         index_map_size_ = size;
+         dsv_index_.row_index.assign(rows,rows + header.row_count);
+         dsv_index_.token_list.view(offsets,header.token_count);
+         dsv_index_.max_column = header.max_column;
+         return true;
+      }
+
+      // Written to the side and renamed into place, so a half written index file never gets used.
+      // Not being able to write it just means indexing again next time.
+      inline void save_index_file(index_file_header header) const
+      {
+         header.row_count   = static_cast<unsigned int>(dsv_index_.row_index.size());
+         header.token_count = static_cast<unsigned int>(dsv_index_.token_list.size());
+         header.max_column  = static_cast<unsigned int>(dsv_index_.max_column);
+
+         const std::string file_name = index_file_name();
+         const std::string temp_file_name = file_name + ".tmp";
+         std::ofstream stream(temp_file_name.c_str(),std::ios::binary);
+         if (!stream)
+            return;
+
+         stream.write(reinterpret_cast<const char*>(&header),sizeof(header));
+         for (std::size_t i = 0; i < dsv_index_.row_index.size(); ++i)
+         {
+            stream.write(reinterpret_cast<const char*>(&dsv_index_.row_index[i]),sizeof(row_index_range_t));
+         }
+         if (!dsv_index_.token_list.empty())
+         {
+            stream.write(reinterpret_cast<const char*>(dsv_index_.token_list.offsets()),
+                         static_cast<std::streamsize>(dsv_index_.token_list.size() * sizeof(token_index::offset_t)));
+         }
+         stream.close();
 
-         if (!options_.support_dquotes)
+         if (!stream)
+            std::remove(temp_file_name.c_str());
+         else
+         {
+            std::remove(file_name.c_str());
+            std::rename(temp_file_name.c_str(),file_name.c_str());
+         }
+      }
+
+      static inline void index_rows(const options& opts, iterator_t begin, iterator_t end, store& idx)
+      {
+         #ifdef strtk_enable_sse2
+         if (!split_options::perform_include_1st_delimiter(opts.column_split_option) &&
+             !split_options::perform_include_all_delimiters(opts.column_split_option))
+         {
+            structural_indexer(opts,idx).index(begin,end);
+            return;
+         }
+         #endif
+
+         multiple_char_delimiter_predicate text_newline_predicate(opts.row_delimiters);
+
+         if (!opts.support_dquotes)
          {
-            multiple_char_delimiter_predicate token_predicate(options_.column_delimiters);
+            multiple_char_delimiter_predicate token_predicate(opts.column_delimiters);
             strtk::split(text_newline_predicate,
-                         buffer_, buffer_ + buffer_size_,
+                         begin, end,
                          strtk::functional_inserter(
-                            row_processor<multiple_char_delimiter_predicate>(dsv_index_,token_predicate,options_.column_split_option)),
+                            row_processor<multiple_char_delimiter_predicate>(idx,token_predicate,opts.column_split_option)),
                          strtk::split_options::compress_delimiters);
          }
          else
          {
-            double_quotes_predicate token_predicate_dblq(options_.column_delimiters);
+            double_quotes_predicate token_predicate_dblq(opts.column_delimiters);
             strtk::split(text_newline_predicate,
-                         buffer_, buffer_ + buffer_size_,
+                         begin, end,
                          strtk::functional_inserter(
-                            row_processor<double_quotes_predicate>(dsv_index_,token_predicate_dblq,options_.column_split_option)),
+                            row_processor<double_quotes_predicate>(idx,token_predicate_dblq,opts.column_split_option)),
                         strtk::split_options::compress_delimiters);
          }
-         update_minmax_columns();
-         return true;
+      }
+
+      // A few chunks per thread to even out rows that tokenize slower than others,
+      // but none smaller than a megabyte, where starting threads would cost more than it saves
+      inline std::size_t index_chunk_count() const
+      {
+         #ifdef _OPENMP
+            const std::size_t thread_count = static_cast<std::size_t>(omp_get_max_threads());
+            if (!options_.parallel_index || (thread_count < 2))
+               return 1;
+            return std::max<std::size_t>(1,std::min<std::size_t>(4 * thread_count,buffer_size_ / one_megabyte));
+         #else
+            return 1;
+         #endif
+      }
+
+      // Cut the buffer just past a row delimiter near every 1/chunk_count of the way through, index each
+      // chunk into its own store, then stitch the stores together shifting each row's token indices along.
+      // Rows are split on row delimiters whether or not they're in quotes and nothing carries over from
+      // one row to the next, so a chunk boundary never changes what gets indexed.
+      inline void index_chunks(const std::size_t chunk_count)
+      {
+         const int chunks = static_cast<int>(chunk_count);
+         iterator_t end = buffer_ + buffer_size_;
+         std::vector<iterator_t> bounds(chunk_count + 1,end);
+         bounds[0] = buffer_;
+
+         multiple_char_delimiter_predicate text_newline_predicate(options_.row_delimiters);
+
+         for (std::size_t i = 1; i < chunk_count; ++i)
+         {
+            iterator_t itr = std::max<iterator_t>(bounds[i - 1],buffer_ + (buffer_size_ / chunk_count) * i);
+            while ((end != itr) && !text_newline_predicate(*itr)) ++itr;
+            if (end != itr) ++itr;
+            bounds[i] = itr;
+         }
+
+         std::vector<store> stores(chunk_count);
+
+         #ifdef _OPENMP
+            #pragma omp parallel for schedule(dynamic)
+         #endif
+         for (int i = 0; i < chunks; ++i)
+         {
+            // Offsets from the start of the whole buffer, so they copy straight across
+            stores[i].token_list.reset(buffer_,end);
+            index_rows(options_,bounds[i],bounds[i + 1],stores[i]);
+         }
+
+         std::vector<std::size_t> token_offset(chunk_count,0);
+         std::vector<std::size_t> row_offset(chunk_count,0);
+         std::size_t token_total = 0;
+         std::size_t row_total = 0;
+         dsv_index_.max_column = std::numeric_limits<std::size_t>::min();
+
+         for (std::size_t i = 0; i < chunk_count; ++i)
+         {
+            token_offset[i] = token_total;
+            row_offset[i]   = row_total;
+            token_total += stores[i].token_list.size();
+            row_total   += stores[i].row_index.size();
+            dsv_index_.max_column = std::max(dsv_index_.max_column,stores[i].max_column);
+         }
+
+         dsv_index_.token_list.resize(token_total);
+         dsv_index_.row_index.resize(row_total);
+
+         #ifdef _OPENMP
+            #pragma omp parallel for schedule(dynamic)
+         #endif
+         for (int i = 0; i < chunks; ++i)
+         {
+            store& chunk = stores[i];
+            std::copy(chunk.token_list.begin(),chunk.token_list.end(),dsv_index_.token_list.begin() + token_offset[i]);
+            const index_t offset = static_cast<index_t>(token_offset[i]);
+            row_index_t::iterator row = dsv_index_.row_index.begin() + row_offset[i];
+            for (std::size_t r = 0; r < chunk.row_index.size(); ++r, ++row)
+            {
+               row->first  = chunk.row_index[r].first  + offset;
+               row->second = chunk.row_index[r].second + offset;
+            }
+            chunk.clear();
+         }
       }
 
       inline bool load_buffer_from_file()
       {
+         if (options_.memory_map && map_buffer_from_file())
+            return true;
          std::ifstream stream(file_name_.c_str(),std::ios::binary);
          if (!stream)
             return false;
@@ -7017,6 +8616,97 @@ namespace strtk
          return true;
       }
 
+      // Private copy-on-write mapping of the whole file, so nothing gets copied up front and pages
+      // only come in as the tokenizer reaches them. Falls back to reading the file if it can't be mapped.
+      inline bool map_buffer_from_file()
+      {
+         std::size_t size = 0;
+         void* view = map_file(file_name_,true,size);
+         if (0 == view)
+            return false;
+         buffer_size_ = size;
+         #if !defined(WIN32) && defined(MADV_SEQUENTIAL)
+            ::madvise(view,buffer_size_,MADV_SEQUENTIAL);
+         #endif
+         buffer_ = reinterpret_cast<unsigned char*>(view);
+         mapped_ = true;
+         return true;
+      }
+
+      // Maps a whole (non-empty) file, either read only or copy-on-write. Null if it can't be mapped.
+      static inline void* map_file(const std::string& file_name, const bool writable, std::size_t& size)
+      {
+         #ifdef WIN32
+            HANDLE file = CreateFileA(file_name.c_str(),GENERIC_READ,FILE_SHARE_READ,0,OPEN_EXISTING,FILE_FLAG_SEQUENTIAL_SCAN,0);
+            if (INVALID_HANDLE_VALUE == file)
+               return 0;
+            LARGE_INTEGER file_size;
+            if (!GetFileSizeEx(file,&file_size) || (0 == file_size.QuadPart))
+            {
+               CloseHandle(file);
+               return 0;
+            }
+            HANDLE mapping = CreateFileMappingA(file,0,writable ? PAGE_WRITECOPY : PAGE_READONLY,0,0,0);
+            void* view = (0 != mapping) ? MapViewOfFile(mapping,writable ? FILE_MAP_COPY : FILE_MAP_READ,0,0,0) : 0;
+            // The view keeps the mapping and the file open by itself
+            if (0 != mapping)
+               CloseHandle(mapping);
+            CloseHandle(file);
+            if (0 == view)
+               return 0;
+            size = static_cast<std::size_t>(file_size.QuadPart);
+         #else
+            int file = ::open(file_name.c_str(),O_RDONLY);
+            if (file < 0)
+               return 0;
+            struct stat info;
+            if ((0 != ::fstat(file,&info)) || (0 == info.st_size))
+            {
+               ::close(file);
+               return 0;
+            }
+            void* view = ::mmap(0,static_cast<std::size_t>(info.st_size),writable ? (PROT_READ | PROT_WRITE) : PROT_READ,MAP_PRIVATE,file,0);
+            ::close(file);
+            if (MAP_FAILED == view)
+               return 0;
+            size = static_cast<std::size_t>(info.st_size);
+         #endif
+         return view;
+      }
+
+      static inline void unmap_file(void* view, const std::size_t& size)
+      {
+         #ifdef WIN32
+            (void)size;
+            UnmapViewOfFile(view);
+         #else
+            ::munmap(view,size);
+         #endif
+      }
+
+      // Give back a buffer we loaded ourselves, however it was loaded, along with any index file
+      // mapped for it (the index is no use without the buffer)
+      inline void release_buffer()
+      {
+         if (0 != index_map_)
+         {
+            dsv_index_.token_list.clear();
+            unmap_file(index_map_,index_map_size_);
+            index_map_ = 0;
+            index_map_size_ = 0;
+         }
+         if (0 == buffer_)
+            return;
+         else if (mapped_)
+         {
+            unmap_file(buffer_,buffer_size_);
+            mapped_ = false;
+         }
+         else
+            delete [] buffer_;
+         buffer_ = 0;
+      }
+
       template <typename OutputIterator>
       inline void process_token(const range_t& range, OutputIterator out) const
       {
@@ -7037,6 +8727,26 @@ namespace strtk
          }
       }
 
+      // The first column of the header row with that name (ignoring case)
+      inline bool find_header_column(const column_schema& schema, const std::string& name, std::size_t& column) const
+      {
+         if (!schema.header_row() || dsv_index_.row_index.empty())
+            return false;
+         const row_type header(0,dsv_index_);
+         for (std::size_t c = 0; c < header.size(); ++c)
+         {
+            const range_t token = header.token(c);
+            if (imatch(token.first,token.second,
+                       reinterpret_cast<const unsigned char*>(name.data()),
+                       reinterpret_cast<const unsigned char*>(name.data() + name.size())))
+            {
+               column = c;
+               return true;
+            }
+         }
+         return false;
+      }
+
       inline bool row_range_invalid(const row_range_t& row_range) const
       {
          if (row_range.first > dsv_index_.row_index.size())
@@ -7074,9 +8784,257 @@ namespace strtk
       std::size_t max_column_count_;
       options options_;
       bool load_from_file_;
+      bool mapped_;
+      void* index_map_;
+      std::size_t index_map_size_;
       bool state_;
    };
 
+   // Binds the columns of a token_grid to the fields of a struct. The fields get declared once,
+   // each with the header names it might go by, using the strtk_bind macros at global scope:
+   //
+   //    strtk_bind_begin(player)
+   //       strtk_bind_column   (name,  "name|player")
+   //       strtk_bind_column_at(gp,    "gp|games",0)
+   //       strtk_bind_optional (plus_minus,"+/-")
+   //    strtk_bind_end()
+   //
+   // resolve() then works out which column each field is in, once per grid, and parse() fills
+   // a struct from a row. Everything's expanded per struct, so parse() comes out as straight
+   // line conversions with no lookups left in it.
+   template <typename Type> struct grid_binding_fields;
+
+   template <typename Type>
+   class grid_binding
+   {
+   public:
+
+      static const std::size_t no_column = static_cast<std::size_t>(-1);
+
+      grid_binding()
+      : first_row_(0)
+      {}
+
+      // If the first row has any of the field names in it, it's taken as the header row and every
+      // required field has to turn up in it exactly once. Otherwise the grid has no header, and
+      // fields go by the positions they were declared with (the _at macros). Returns false with
+      // a message in error if a required column can't be found or more than one column matches.
+      inline bool resolve(const token_grid& grid, std::string& error)
+      {
+         column_list_.clear();
+         first_row_ = 0;
+         error.clear();
+         if (0 == grid.row_count())
+         {
+            error = "no rows to bind";
+            return false;
+         }
+         header_finder finder(grid.row(0),column_list_);
+         grid_binding_fields<Type>::visit(finder);
+         if (finder.found)
+         {
+            header_checker checker(column_list_,error);
+            grid_binding_fields<Type>::visit(checker);
+            first_row_ = 1;
+         }
+         else
+         {
+            position_taker taker(column_list_,error);
+            grid_binding_fields<Type>::visit(taker);
+         }
+         return error.empty();
+      }
+
+      // The first row that holds data, 1 when there's a header row
+      inline std::size_t first_row() const
+      {
+         return first_row_;
+      }
+
+      // Column the n'th declared field was bound to, or no_column
+      inline std::size_t column(const std::size_t& field) const
+      {
+         return (field < column_list_.size()) ? column_list_[field] : no_column;
+      }
+
+      // Fills in t from the row. Optional fields that aren't in the grid or the row are left alone.
+      // False if the row's missing a required column or a token doesn't convert to its field.
+      inline bool parse(const token_grid::row_type& row, Type& t) const
+      {
+         row_parser parser(row,column_list_,t);
+         grid_binding_fields<Type>::visit(parser);
+         return parser.result;
+      }
+
+   private:
+
+      struct header_finder
+      {
+         header_finder(const token_grid::row_type& h, std::vector<std::size_t>& cl)
+         : found(false),
+           header(h),
+           column_list(cl)
+         {}
+
+         template <typename T>
+         inline void operator()(const char* aliases, T Type::*, const std::size_t&, const bool)
+         {
+            std::size_t column = no_column;
+            const std::size_t count = find_column(header,aliases,column);
+            if (0 != count)
+               found = true;
+            // Duplicates are marked past the end of any row so header_checker can spot them
+            column_list.push_back((count > 1) ? no_column - 1 : column);
+         }
+
+         bool found;
+         token_grid::row_type header;
+         std::vector<std::size_t>& column_list;
+
+         // Header comparison ignores case, and anything around the name that isn't printable ASCII
+         // (spaces, a stray CR, byte order marks and the like from whatever exported the file)
+         static inline bool header_match(const char* alias_begin, const char* alias_end, const token_grid::range_t& token)
+         {
+            const unsigned char* begin = token.first;
+            const unsigned char* end   = token.second;
+            while ((begin != end) && ((*begin <= ' ') || (*begin >= 0x7F))) ++begin;
+            while ((begin != end) && ((*(end - 1) <= ' ') || (*(end - 1) >= 0x7F))) --end;
+            return imatch(begin,end,
+                          reinterpret_cast<const unsigned char*>(alias_begin),
+                          reinterpret_cast<const unsigned char*>(alias_end));
+         }
+
+         // Columns in the row that go by any of the '|' separated aliases, counted up to two
+         static inline std::size_t find_column(const token_grid::row_type& header, const char* aliases, std::size_t& column)
+         {
+            std::size_t count = 0;
+            column = no_column;
+            for (std::size_t c = 0; c < header.size(); ++c)
+            {
+               const char* alias = aliases;
+               while (0 != *alias)
+               {
+                  const char* alias_end = alias;
+                  while ((0 != *alias_end) && ('|' != *alias_end)) ++alias_end;
+                  if (header_match(alias,alias_end,header.token(c)))
+                  {
+                     if (0 == count++)
+                        column = c;
+                     break;
+                  }
+                  alias = ('|' == *alias_end) ? alias_end + 1 : alias_end;
+               }
+               if (count > 1)
+                  break;
+            }
+            return count;
+         }
+      };
+
+      struct header_checker
+      {
+         header_checker(std::vector<std::size_t>& cl, std::string& e)
+         : field(0),
+           column_list(cl),
+           error(e)
+         {}
+
+         template <typename T>
+         inline void operator()(const char* aliases, T Type::*, const std::size_t&, const bool required)
+         {
+            std::size_t& column = column_list[field++];
+            if ((no_column - 1) == column)
+            {
+               error += std::string(error.empty() ? "" : ", ") + "more than one column for '" + aliases + "'";
+               column = no_column;
+            }
+            else if (required && (no_column == column))
+               error += std::string(error.empty() ? "" : ", ") + "no column for '" + aliases + "'";
+         }
+
+         std::size_t field;
+         std::vector<std::size_t>& column_list;
+         std::string& error;
+      };
+
+      struct position_taker
+      {
+         position_taker(std::vector<std::size_t>& cl, std::string& e)
+         : field(0),
+           column_list(cl),
+           error(e)
+         {}
+
+         template <typename T>
+         inline void operator()(const char* aliases, T Type::*, const std::size_t& position, const bool required)
+         {
+            column_list[field++] = position;
+            if (required && (no_column == position))
+               error += std::string(error.empty() ? "" : ", ") + "no header row to find '" + aliases + "' in";
+         }
+
+         std::size_t field;
+         std::vector<std::size_t>& column_list;
+         std::string& error;
+      };
+
+      struct row_parser
+      {
+         row_parser(const token_grid::row_type& r, const std::vector<std::size_t>& cl, Type& t)
+         : result(true),
+           field(0),
+           row(r),
+           column_list(cl),
+           value(t)
+         {}
+
+         template <typename T>
+         inline void operator()(const char*, T Type::* member, const std::size_t&, const bool required)
+         {
+            const std::size_t column = column_list[field++];
+            if (column < row.size())
+            {
+               const token_grid::range_t token = row.token(column);
+               if (!string_to_type_converter(token.first,token.second,value.*member))
+                  result = false;
+            }
+            else if (required)
+               result = false;
+         }
+
+         bool result;
+         std::size_t field;
+         const token_grid::row_type& row;
+         const std::vector<std::size_t>& column_list;
+         Type& value;
+      };
+
+      std::vector<std::size_t> column_list_;
+      std::size_t first_row_;
+   };
+
+   #define strtk_bind_begin(Type)\
+   namespace strtk {\
+   template <> struct grid_binding_fields<Type> {\
+   typedef Type type;\
+   template <typename Visitor>\
+   static inline void visit(Visitor& v) {
+
+   #define strtk_bind_column(Member,Aliases)\
+   v(Aliases,&type::Member,static_cast<std::size_t>(-1),true);
+
+   #define strtk_bind_column_at(Member,Aliases,Position)\
+   v(Aliases,&type::Member,static_cast<std::size_t>(Position),true);
+
+   #define strtk_bind_optional(Member,Aliases)\
+   v(Aliases,&type::Member,static_cast<std::size_t>(-1),false);
+
+   #define strtk_bind_optional_at(Member,Aliases,Position)\
+   v(Aliases,&type::Member,static_cast<std::size_t>(Position),false);
+
+   #define strtk_bind_end()\
+   }};}
+
    template <typename T>
    inline bool convert_string_range(const std::pair<std::string::const_iterator,std::string::const_iterator>& range, T& t)
    {
@@ -12766,6 +14724,684 @@ namespace strtk
          return signed_numeric_convert<T,const char*>(s.size(),s.data(),t,digit_check);
       }
 
+      namespace details
+      {
+         // 5^q for q in [-342,308], each as the top 128 bits (hi,lo) of the value scaled into [2^127,2^128),
+         // rounded down for q >= 0 and up for q < 0. That's all Eisel-Lemire needs to know about 10^q.
+         inline const unsigned long long int* power_of_five_128()
+         {
+            static const unsigned long long int table[] =
+                         {
+                            0xEEF453D6923BD65AULL,0x113FAA2906A13B3FULL,0x9558B4661B6565F8ULL,0x4AC7CA59A424C507ULL,
+                            0xBAAEE17FA23EBF76ULL,0x5D79BCF00D2DF649ULL,0xE95A99DF8ACE6F53ULL,0xF4D82C2C107973DCULL,
+                            0x91D8A02BB6C10594ULL,0x79071B9B8A4BE869ULL,0xB64EC836A47146F9ULL,0x9748E2826CDEE284ULL,
+                            0xE3E27A444D8D98B7ULL,0xFD1B1B2308169B25ULL,0x8E6D8C6AB0787F72ULL,0xFE30F0F5E50E20F7ULL,
+                            0xB208EF855C969F4FULL,0xBDBD2D335E51A935ULL,0xDE8B2B66B3BC4723ULL,0xAD2C788035E61382ULL,
+                            0x8B16FB203055AC76ULL,0x4C3BCB5021AFCC31ULL,0xADDCB9E83C6B1793ULL,0xDF4ABE242A1BBF3DULL,
+                            0xD953E8624B85DD78ULL,0xD71D6DAD34A2AF0DULL,0x87D4713D6F33AA6BULL,0x8672648C40E5AD68ULL,
+                            0xA9C98D8CCB009506ULL,0x680EFDAF511F18C2ULL,0xD43BF0EFFDC0BA48ULL,0x0212BD1B2566DEF2ULL,
+                            0x84A57695FE98746DULL,0x014BB630F7604B57ULL,0xA5CED43B7E3E9188ULL,0x419EA3BD35385E2DULL,
+                            0xCF42894A5DCE35EAULL,0x52064CAC828675B9ULL,0x818995CE7AA0E1B2ULL,0x7343EFEBD1940993ULL,
+                            0xA1EBFB4219491A1FULL,0x1014EBE6C5F90BF8ULL,0xCA66FA129F9B60A6ULL,0xD41A26E077774EF6ULL,
+                            0xFD00B897478238D0ULL,0x8920B098955522B4ULL,0x9E20735E8CB16382ULL,0x55B46E5F5D5535B0ULL,
+                            0xC5A890362FDDBC62ULL,0xEB2189F734AA831DULL,0xF712B443BBD52B7BULL,0xA5E9EC7501D523E4ULL,
+                            0x9A6BB0AA55653B2DULL,0x47B233C92125366EULL,0xC1069CD4EABE89F8ULL,0x999EC0BB696E840AULL,
+                            0xF148440A256E2C76ULL,0xC00670EA43CA250DULL,0x96CD2A865764DBCAULL,0x380406926A5E5728ULL,
+                            0xBC807527ED3E12BCULL,0xC605083704F5ECF2ULL,0xEBA09271E88D976BULL,0xF7864A44C633682EULL,
+                            0x93445B8731587EA3ULL,0x7AB3EE6AFBE0211DULL,0xB8157268FDAE9E4CULL,0x5960EA05BAD82964ULL,
+                            0xE61ACF033D1A45DFULL,0x6FB92487298E33BDULL,0x8FD0C16206306BABULL,0xA5D3B6D479F8E056ULL,
+                            0xB3C4F1BA87BC8696ULL,0x8F48A4899877186CULL,0xE0B62E2929ABA83CULL,0x331ACDABFE94DE87ULL,
+                            0x8C71DCD9BA0B4925ULL,0x9FF0C08B7F1D0B14ULL,0xAF8E5410288E1B6FULL,0x07ECF0AE5EE44DD9ULL,
+                            0xDB71E91432B1A24AULL,0xC9E82CD9F69D6150ULL,0x892731AC9FAF056EULL,0xBE311C083A225CD2ULL,
+                            0xAB70FE17C79AC6CAULL,0x6DBD630A48AAF406ULL,0xD64D3D9DB981787DULL,0x092CBBCCDAD5B108ULL,
+                            0x85F0468293F0EB4EULL,0x25BBF56008C58EA5ULL,0xA76C582338ED2621ULL,0xAF2AF2B80AF6F24EULL,
+                            0xD1476E2C07286FAAULL,0x1AF5AF660DB4AEE1ULL,0x82CCA4DB847945CAULL,0x50D98D9FC890ED4DULL,
+                            0xA37FCE126597973CULL,0xE50FF107BAB528A0ULL,0xCC5FC196FEFD7D0CULL,0x1E53ED49A96272C8ULL,
+                            0xFF77B1FCBEBCDC4FULL,0x25E8E89C13BB0F7AULL,0x9FAACF3DF73609B1ULL,0x77B191618C54E9ACULL,
+                            0xC795830D75038C1DULL,0xD59DF5B9EF6A2417ULL,0xF97AE3D0D2446F25ULL,0x4B0573286B44AD1DULL,
+                            0x9BECCE62836AC577ULL,0x4EE367F9430AEC32ULL,0xC2E801FB244576D5ULL,0x229C41F793CDA73FULL,
+                            0xF3A20279ED56D48AULL,0x6B43527578C1110FULL,0x9845418C345644D6ULL,0x830A13896B78AAA9ULL,
+                            0xBE5691EF416BD60CULL,0x23CC986BC656D553ULL,0xEDEC366B11C6CB8FULL,0x2CBFBE86B7EC8AA8ULL,
+                            0x94B3A202EB1C3F39ULL,0x7BF7D71432F3D6A9ULL,0xB9E08A83A5E34F07ULL,0xDAF5CCD93FB0CC53ULL,
+                            0xE858AD248F5C22C9ULL,0xD1B3400F8F9CFF68ULL,0x91376C36D99995BEULL,0x23100809B9C21FA1ULL,
+                            0xB58547448FFFFB2DULL,0xABD40A0C2832A78AULL,0xE2E69915B3FFF9F9ULL,0x16C90C8F323F516CULL,
+                            0x8DD01FAD907FFC3BULL,0xAE3DA7D97F6792E3ULL,0xB1442798F49FFB4AULL,0x99CD11CFDF41779CULL,
+                            0xDD95317F31C7FA1DULL,0x40405643D711D583ULL,0x8A7D3EEF7F1CFC52ULL,0x482835EA666B2572ULL,
+                            0xAD1C8EAB5EE43B66ULL,0xDA3243650005EECFULL,0xD863B256369D4A40ULL,0x90BED43E40076A82ULL,
+                            0x873E4F75E2224E68ULL,0x5A7744A6E804A291ULL,0xA90DE3535AAAE202ULL,0x711515D0A205CB36ULL,
+                            0xD3515C2831559A83ULL,0x0D5A5B44CA873E03ULL,0x8412D9991ED58091ULL,0xE858790AFE9486C2ULL,
+                            0xA5178FFF668AE0B6ULL,0x626E974DBE39A872ULL,0xCE5D73FF402D98E3ULL,0xFB0A3D212DC8128FULL,
+                            0x80FA687F881C7F8EULL,0x7CE66634BC9D0B99ULL,0xA139029F6A239F72ULL,0x1C1FFFC1EBC44E80ULL,
+                            0xC987434744AC874EULL,0xA327FFB266B56220ULL,0xFBE9141915D7A922ULL,0x4BF1FF9F0062BAA8ULL,
+                            0x9D71AC8FADA6C9B5ULL,0x6F773FC3603DB4A9ULL,0xC4CE17B399107C22ULL,0xCB550FB4384D21D3ULL,
+                            0xF6019DA07F549B2BULL,0x7E2A53A146606A48ULL,0x99C102844F94E0FBULL,0x2EDA7444CBFC426DULL,
+                            0xC0314325637A1939ULL,0xFA911155FEFB5308ULL,0xF03D93EEBC589F88ULL,0x793555AB7EBA27CAULL,
+                            0x96267C7535B763B5ULL,0x4BC1558B2F3458DEULL,0xBBB01B9283253CA2ULL,0x9EB1AAEDFB016F16ULL,
+                            0xEA9C227723EE8BCBULL,0x465E15A979C1CADCULL,0x92A1958A7675175FULL,0x0BFACD89EC191EC9ULL,
+                            0xB749FAED14125D36ULL,0xCEF980EC671F667BULL,0xE51C79A85916F484ULL,0x82B7E12780E7401AULL,
+                            0x8F31CC0937AE58D2ULL,0xD1B2ECB8B0908810ULL,0xB2FE3F0B8599EF07ULL,0x861FA7E6DCB4AA15ULL,
+                            0xDFBDCECE67006AC9ULL,0x67A791E093E1D49AULL,0x8BD6A141006042BDULL,0xE0C8BB2C5C6D24E0ULL,
+                            0xAECC49914078536DULL,0x58FAE9F773886E18ULL,0xDA7F5BF590966848ULL,0xAF39A475506A899EULL,
+                            0x888F99797A5E012DULL,0x6D8406C952429603ULL,0xAAB37FD7D8F58178ULL,0xC8E5087BA6D33B83ULL,
+                            0xD5605FCDCF32E1D6ULL,0xFB1E4A9A90880A64ULL,0x855C3BE0A17FCD26ULL,0x5CF2EEA09A55067FULL,
+                            0xA6B34AD8C9DFC06FULL,0xF42FAA48C0EA481EULL,0xD0601D8EFC57B08BULL,0xF13B94DAF124DA26ULL,
+                            0x823C12795DB6CE57ULL,0x76C53D08D6B70858ULL,0xA2CB1717B52481EDULL,0x54768C4B0C64CA6EULL,
+                            0xCB7DDCDDA26DA268ULL,0xA9942F5DCF7DFD09ULL,0xFE5D54150B090B02ULL,0xD3F93B35435D7C4CULL,
+                            0x9EFA548D26E5A6E1ULL,0xC47BC5014A1A6DAFULL,0xC6B8E9B0709F109AULL,0x359AB6419CA1091BULL,
+                            0xF867241C8CC6D4C0ULL,0xC30163D203C94B62ULL,0x9B407691D7FC44F8ULL,0x79E0DE63425DCF1DULL,
+                            0xC21094364DFB5636ULL,0x985915FC12F542E4ULL,0xF294B943E17A2BC4ULL,0x3E6F5B7B17B2939DULL,
+                            0x979CF3CA6CEC5B5AULL,0xA705992CEECF9C42ULL,0xBD8430BD08277231ULL,0x50C6FF782A838353ULL,
+                            0xECE53CEC4A314EBDULL,0xA4F8BF5635246428ULL,0x940F4613AE5ED136ULL,0x871B7795E136BE99ULL,
+                            0xB913179899F68584ULL,0x28E2557B59846E3FULL,0xE757DD7EC07426E5ULL,0x331AEADA2FE589CFULL,
+                            0x9096EA6F3848984FULL,0x3FF0D2C85DEF7621ULL,0xB4BCA50B065ABE63ULL,0x0FED077A756B53A9ULL,
+                            0xE1EBCE4DC7F16DFBULL,0xD3E8495912C62894ULL,0x8D3360F09CF6E4BDULL,0x64712DD7ABBBD95CULL,
+                            0xB080392CC4349DECULL,0xBD8D794D96AACFB3ULL,0xDCA04777F541C567ULL,0xECF0D7A0FC5583A0ULL,
+                            0x89E42CAAF9491B60ULL,0xF41686C49DB57244ULL,0xAC5D37D5B79B6239ULL,0x311C2875C522CED5ULL,
+                            0xD77485CB25823AC7ULL,0x7D633293366B828BULL,0x86A8D39EF77164BCULL,0xAE5DFF9C02033197ULL,
+                            0xA8530886B54DBDEBULL,0xD9F57F830283FDFCULL,0xD267CAA862A12D66ULL,0xD072DF63C324FD7BULL,
+                            0x8380DEA93DA4BC60ULL,0x4247CB9E59F71E6DULL,0xA46116538D0DEB78ULL,0x52D9BE85F074E608ULL,
+                            0xCD795BE870516656ULL,0x67902E276C921F8BULL,0x806BD9714632DFF6ULL,0x00BA1CD8A3DB53B6ULL,
+                            0xA086CFCD97BF97F3ULL,0x80E8A40ECCD228A4ULL,0xC8A883C0FDAF7DF0ULL,0x6122CD128006B2CDULL,
+                            0xFAD2A4B13D1B5D6CULL,0x796B805720085F81ULL,0x9CC3A6EEC6311A63ULL,0xCBE3303674053BB0ULL,
+                            0xC3F490AA77BD60FCULL,0xBEDBFC4411068A9CULL,0xF4F1B4D515ACB93BULL,0xEE92FB5515482D44ULL,
+                            0x991711052D8BF3C5ULL,0x751BDD152D4D1C4AULL,0xBF5CD54678EEF0B6ULL,0xD262D45A78A0635DULL,
+                            0xEF340A98172AACE4ULL,0x86FB897116C87C34ULL,0x9580869F0E7AAC0EULL,0xD45D35E6AE3D4DA0ULL,
+                            0xBAE0A846D2195712ULL,0x8974836059CCA109ULL,0xE998D258869FACD7ULL,0x2BD1A438703FC94BULL,
+                            0x91FF83775423CC06ULL,0x7B6306A34627DDCFULL,0xB67F6455292CBF08ULL,0x1A3BC84C17B1D542ULL,
+                            0xE41F3D6A7377EECAULL,0x20CABA5F1D9E4A93ULL,0x8E938662882AF53EULL,0x547EB47B7282EE9CULL,
+                            0xB23867FB2A35B28DULL,0xE99E619A4F23AA43ULL,0xDEC681F9F4C31F31ULL,0x6405FA00E2EC94D4ULL,
+                            0x8B3C113C38F9F37EULL,0xDE83BC408DD3DD04ULL,0xAE0B158B4738705EULL,0x9624AB50B148D445ULL,
+                            0xD98DDAEE19068C76ULL,0x3BADD624DD9B0957ULL,0x87F8A8D4CFA417C9ULL,0xE54CA5D70A80E5D6ULL,
+                            0xA9F6D30A038D1DBCULL,0x5E9FCF4CCD211F4CULL,0xD47487CC8470652BULL,0x7647C3200069671FULL,
+                            0x84C8D4DFD2C63F3BULL,0x29ECD9F40041E073ULL,0xA5FB0A17C777CF09ULL,0xF468107100525890ULL,
+                            0xCF79CC9DB955C2CCULL,0x7182148D4066EEB4ULL,0x81AC1FE293D599BFULL,0xC6F14CD848405530ULL,
+                            0xA21727DB38CB002FULL,0xB8ADA00E5A506A7CULL,0xCA9CF1D206FDC03BULL,0xA6D90811F0E4851CULL,
+                            0xFD442E4688BD304AULL,0x908F4A166D1DA663ULL,0x9E4A9CEC15763E2EULL,0x9A598E4E043287FEULL,
+                            0xC5DD44271AD3CDBAULL,0x40EFF1E1853F29FDULL,0xF7549530E188C128ULL,0xD12BEE59E68EF47CULL,
+                            0x9A94DD3E8CF578B9ULL,0x82BB74F8301958CEULL,0xC13A148E3032D6E7ULL,0xE36A52363C1FAF01ULL,
+                            0xF18899B1BC3F8CA1ULL,0xDC44E6C3CB279AC1ULL,0x96F5600F15A7B7E5ULL,0x29AB103A5EF8C0B9ULL,
+                            0xBCB2B812DB11A5DEULL,0x7415D448F6B6F0E7ULL,0xEBDF661791D60F56ULL,0x111B495B3464AD21ULL,
+                            0x936B9FCEBB25C995ULL,0xCAB10DD900BEEC34ULL,0xB84687C269EF3BFBULL,0x3D5D514F40EEA742ULL,
+                            0xE65829B3046B0AFAULL,0x0CB4A5A3112A5112ULL,0x8FF71A0FE2C2E6DCULL,0x47F0E785EABA72ABULL,
+                            0xB3F4E093DB73A093ULL,0x59ED216765690F56ULL,0xE0F218B8D25088B8ULL,0x306869C13EC3532CULL,
+                            0x8C974F7383725573ULL,0x1E414218C73A13FBULL,0xAFBD2350644EEACFULL,0xE5D1929EF90898FAULL,
+                            0xDBAC6C247D62A583ULL,0xDF45F746B74ABF39ULL,0x894BC396CE5DA772ULL,0x6B8BBA8C328EB783ULL,
+                            0xAB9EB47C81F5114FULL,0x066EA92F3F326564ULL,0xD686619BA27255A2ULL,0xC80A537B0EFEFEBDULL,
+                            0x8613FD0145877585ULL,0xBD06742CE95F5F36ULL,0xA798FC4196E952E7ULL,0x2C48113823B73704ULL,
+                            0xD17F3B51FCA3A7A0ULL,0xF75A15862CA504C5ULL,0x82EF85133DE648C4ULL,0x9A984D73DBE722FBULL,
+                            0xA3AB66580D5FDAF5ULL,0xC13E60D0D2E0EBBAULL,0xCC963FEE10B7D1B3ULL,0x318DF905079926A8ULL,
+                            0xFFBBCFE994E5C61FULL,0xFDF17746497F7052ULL,0x9FD561F1FD0F9BD3ULL,0xFEB6EA8BEDEFA633ULL,
+                            0xC7CABA6E7C5382C8ULL,0xFE64A52EE96B8FC0ULL,0xF9BD690A1B68637BULL,0x3DFDCE7AA3C673B0ULL,
+                            0x9C1661A651213E2DULL,0x06BEA10CA65C084EULL,0xC31BFA0FE5698DB8ULL,0x486E494FCFF30A62ULL,
+                            0xF3E2F893DEC3F126ULL,0x5A89DBA3C3EFCCFAULL,0x986DDB5C6B3A76B7ULL,0xF89629465A75E01CULL,
+                            0xBE89523386091465ULL,0xF6BBB397F1135823ULL,0xEE2BA6C0678B597FULL,0x746AA07DED582E2CULL,
+                            0x94DB483840B717EFULL,0xA8C2A44EB4571CDCULL,0xBA121A4650E4DDEBULL,0x92F34D62616CE413ULL,
+                            0xE896A0D7E51E1566ULL,0x77B020BAF9C81D17ULL,0x915E2486EF32CD60ULL,0x0ACE1474DC1D122EULL,
+                            0xB5B5ADA8AAFF80B8ULL,0x0D819992132456BAULL,0xE3231912D5BF60E6ULL,0x10E1FFF697ED6C69ULL,
+                            0x8DF5EFABC5979C8FULL,0xCA8D3FFA1EF463C1ULL,0xB1736B96B6FD83B3ULL,0xBD308FF8A6B17CB2ULL,
+                            0xDDD0467C64BCE4A0ULL,0xAC7CB3F6D05DDBDEULL,0x8AA22C0DBEF60EE4ULL,0x6BCDF07A423AA96BULL,
+                            0xAD4AB7112EB3929DULL,0x86C16C98D2C953C6ULL,0xD89D64D57A607744ULL,0xE871C7BF077BA8B7ULL,
+                            0x87625F056C7C4A8BULL,0x11471CD764AD4972ULL,0xA93AF6C6C79B5D2DULL,0xD598E40D3DD89BCFULL,
+                            0xD389B47879823479ULL,0x4AFF1D108D4EC2C3ULL,0x843610CB4BF160CBULL,0xCEDF722A585139BAULL,
+                            0xA54394FE1EEDB8FEULL,0xC2974EB4EE658828ULL,0xCE947A3DA6A9273EULL,0x733D226229FEEA32ULL,
+                            0x811CCC668829B887ULL,0x0806357D5A3F525FULL,0xA163FF802A3426A8ULL,0xCA07C2DCB0CF26F7ULL,
+                            0xC9BCFF6034C13052ULL,0xFC89B393DD02F0B5ULL,0xFC2C3F3841F17C67ULL,0xBBAC2078D443ACE2ULL,
+                            0x9D9BA7832936EDC0ULL,0xD54B944B84AA4C0DULL,0xC5029163F384A931ULL,0x0A9E795E65D4DF11ULL,
+                            0xF64335BCF065D37DULL,0x4D4617B5FF4A16D5ULL,0x99EA0196163FA42EULL,0x504BCED1BF8E4E45ULL,
+                            0xC06481FB9BCF8D39ULL,0xE45EC2862F71E1D6ULL,0xF07DA27A82C37088ULL,0x5D767327BB4E5A4CULL,
+                            0x964E858C91BA2655ULL,0x3A6A07F8D510F86FULL,0xBBE226EFB628AFEAULL,0x890489F70A55368BULL,
+                            0xEADAB0ABA3B2DBE5ULL,0x2B45AC74CCEA842EULL,0x92C8AE6B464FC96FULL,0x3B0B8BC90012929DULL,
+                            0xB77ADA0617E3BBCBULL,0x09CE6EBB40173744ULL,0xE55990879DDCAABDULL,0xCC420A6A101D0515ULL,
+                            0x8F57FA54C2A9EAB6ULL,0x9FA946824A12232DULL,0xB32DF8E9F3546564ULL,0x47939822DC96ABF9ULL,
+                            0xDFF9772470297EBDULL,0x59787E2B93BC56F7ULL,0x8BFBEA76C619EF36ULL,0x57EB4EDB3C55B65AULL,
+                            0xAEFAE51477A06B03ULL,0xEDE622920B6B23F1ULL,0xDAB99E59958885C4ULL,0xE95FAB368E45ECEDULL,
+                            0x88B402F7FD75539BULL,0x11DBCB0218EBB414ULL,0xAAE103B5FCD2A881ULL,0xD652BDC29F26A119ULL,
+                            0xD59944A37C0752A2ULL,0x4BE76D3346F0495FULL,0x857FCAE62D8493A5ULL,0x6F70A4400C562DDBULL,
+                            0xA6DFBD9FB8E5B88EULL,0xCB4CCD500F6BB952ULL,0xD097AD07A71F26B2ULL,0x7E2000A41346A7A7ULL,
+                            0x825ECC24C873782FULL,0x8ED400668C0C28C8ULL,0xA2F67F2DFA90563BULL,0x728900802F0F32FAULL,
+                            0xCBB41EF979346BCAULL,0x4F2B40A03AD2FFB9ULL,0xFEA126B7D78186BCULL,0xE2F610C84987BFA8ULL,
+                            0x9F24B832E6B0F436ULL,0x0DD9CA7D2DF4D7C9ULL,0xC6EDE63FA05D3143ULL,0x91503D1C79720DBBULL,
+                            0xF8A95FCF88747D94ULL,0x75A44C6397CE912AULL,0x9B69DBE1B548CE7CULL,0xC986AFBE3EE11ABAULL,
+                            0xC24452DA229B021BULL,0xFBE85BADCE996168ULL,0xF2D56790AB41C2A2ULL,0xFAE27299423FB9C3ULL,
+                            0x97C560BA6B0919A5ULL,0xDCCD879FC967D41AULL,0xBDB6B8E905CB600FULL,0x5400E987BBC1C920ULL,
+                            0xED246723473E3813ULL,0x290123E9AAB23B68ULL,0x9436C0760C86E30BULL,0xF9A0B6720AAF6521ULL,
+                            0xB94470938FA89BCEULL,0xF808E40E8D5B3E69ULL,0xE7958CB87392C2C2ULL,0xB60B1D1230B20E04ULL,
+                            0x90BD77F3483BB9B9ULL,0xB1C6F22B5E6F48C2ULL,0xB4ECD5F01A4AA828ULL,0x1E38AEB6360B1AF3ULL,
+                            0xE2280B6C20DD5232ULL,0x25C6DA63C38DE1B0ULL,0x8D590723948A535FULL,0x579C487E5A38AD0EULL,
+                            0xB0AF48EC79ACE837ULL,0x2D835A9DF0C6D851ULL,0xDCDB1B2798182244ULL,0xF8E431456CF88E65ULL,
+                            0x8A08F0F8BF0F156BULL,0x1B8E9ECB641B58FFULL,0xAC8B2D36EED2DAC5ULL,0xE272467E3D222F3FULL,
+                            0xD7ADF884AA879177ULL,0x5B0ED81DCC6ABB0FULL,0x86CCBB52EA94BAEAULL,0x98E947129FC2B4E9ULL,
+                            0xA87FEA27A539E9A5ULL,0x3F2398D747B36224ULL,0xD29FE4B18E88640EULL,0x8EEC7F0D19A03AADULL,
+                            0x83A3EEEEF9153E89ULL,0x1953CF68300424ACULL,0xA48CEAAAB75A8E2BULL,0x5FA8C3423C052DD7ULL,
+                            0xCDB02555653131B6ULL,0x3792F412CB06794DULL,0x808E17555F3EBF11ULL,0xE2BBD88BBEE40BD0ULL,
+                            0xA0B19D2AB70E6ED6ULL,0x5B6ACEAEAE9D0EC4ULL,0xC8DE047564D20A8BULL,0xF245825A5A445275ULL,
+                            0xFB158592BE068D2EULL,0xEED6E2F0F0D56712ULL,0x9CED737BB6C4183DULL,0x55464DD69685606BULL,
+                            0xC428D05AA4751E4CULL,0xAA97E14C3C26B886ULL,0xF53304714D9265DFULL,0xD53DD99F4B3066A8ULL,
+                            0x993FE2C6D07B7FABULL,0xE546A8038EFE4029ULL,0xBF8FDB78849A5F96ULL,0xDE98520472BDD033ULL,
+                            0xEF73D256A5C0F77CULL,0x963E66858F6D4440ULL,0x95A8637627989AADULL,0xDDE7001379A44AA8ULL,
+                            0xBB127C53B17EC159ULL,0x5560C018580D5D52ULL,0xE9D71B689DDE71AFULL,0xAAB8F01E6E10B4A6ULL,
+                            0x9226712162AB070DULL,0xCAB3961304CA70E8ULL,0xB6B00D69BB55C8D1ULL,0x3D607B97C5FD0D22ULL,
+                            0xE45C10C42A2B3B05ULL,0x8CB89A7DB77C506AULL,0x8EB98A7A9A5B04E3ULL,0x77F3608E92ADB242ULL,
+                            0xB267ED1940F1C61CULL,0x55F038B237591ED3ULL,0xDF01E85F912E37A3ULL,0x6B6C46DEC52F6688ULL,
+                            0x8B61313BBABCE2C6ULL,0x2323AC4B3B3DA015ULL,0xAE397D8AA96C1B77ULL,0xABEC975E0A0D081AULL,
+                            0xD9C7DCED53C72255ULL,0x96E7BD358C904A21ULL,0x881CEA14545C7575ULL,0x7E50D64177DA2E54ULL,
+                            0xAA242499697392D2ULL,0xDDE50BD1D5D0B9E9ULL,0xD4AD2DBFC3D07787ULL,0x955E4EC64B44E864ULL,
+                            0x84EC3C97DA624AB4ULL,0xBD5AF13BEF0B113EULL,0xA6274BBDD0FADD61ULL,0xECB1AD8AEACDD58EULL,
+                            0xCFB11EAD453994BAULL,0x67DE18EDA5814AF2ULL,0x81CEB32C4B43FCF4ULL,0x80EACF948770CED7ULL,
+                            0xA2425FF75E14FC31ULL,0xA1258379A94D028DULL,0xCAD2F7F5359A3B3EULL,0x096EE45813A04330ULL,
+                            0xFD87B5F28300CA0DULL,0x8BCA9D6E188853FCULL,0x9E74D1B791E07E48ULL,0x775EA264CF55347EULL,
+                            0xC612062576589DDAULL,0x95364AFE032A819EULL,0xF79687AED3EEC551ULL,0x3A83DDBD83F52205ULL,
+                            0x9ABE14CD44753B52ULL,0xC4926A9672793543ULL,0xC16D9A0095928A27ULL,0x75B7053C0F178294ULL,
+                            0xF1C90080BAF72CB1ULL,0x5324C68B12DD6339ULL,0x971DA05074DA7BEEULL,0xD3F6FC16EBCA5E04ULL,
+                            0xBCE5086492111AEAULL,0x88F4BB1CA6BCF585ULL,0xEC1E4A7DB69561A5ULL,0x2B31E9E3D06C32E6ULL,
+                            0x9392EE8E921D5D07ULL,0x3AFF322E62439FD0ULL,0xB877AA3236A4B449ULL,0x09BEFEB9FAD487C3ULL,
+                            0xE69594BEC44DE15BULL,0x4C2EBE687989A9B4ULL,0x901D7CF73AB0ACD9ULL,0x0F9D37014BF60A11ULL,
+                            0xB424DC35095CD80FULL,0x538484C19EF38C95ULL,0xE12E13424BB40E13ULL,0x2865A5F206B06FBAULL,
+                            0x8CBCCC096F5088CBULL,0xF93F87B7442E45D4ULL,0xAFEBFF0BCB24AAFEULL,0xF78F69A51539D749ULL,
+                            0xDBE6FECEBDEDD5BEULL,0xB573440E5A884D1CULL,0x89705F4136B4A597ULL,0x31680A88F8953031ULL,
+                            0xABCC77118461CEFCULL,0xFDC20D2B36BA7C3EULL,0xD6BF94D5E57A42BCULL,0x3D32907604691B4DULL,
+                            0x8637BD05AF6C69B5ULL,0xA63F9A49C2C1B110ULL,0xA7C5AC471B478423ULL,0x0FCF80DC33721D54ULL,
+                            0xD1B71758E219652BULL,0xD3C36113404EA4A9ULL,0x83126E978D4FDF3BULL,0x645A1CAC083126EAULL,
+                            0xA3D70A3D70A3D70AULL,0x3D70A3D70A3D70A4ULL,0xCCCCCCCCCCCCCCCCULL,0xCCCCCCCCCCCCCCCDULL,
+                            0x8000000000000000ULL,0x0000000000000000ULL,0xA000000000000000ULL,0x0000000000000000ULL,
+                            0xC800000000000000ULL,0x0000000000000000ULL,0xFA00000000000000ULL,0x0000000000000000ULL,
+                            0x9C40000000000000ULL,0x0000000000000000ULL,0xC350000000000000ULL,0x0000000000000000ULL,
+                            0xF424000000000000ULL,0x0000000000000000ULL,0x9896800000000000ULL,0x0000000000000000ULL,
+                            0xBEBC200000000000ULL,0x0000000000000000ULL,0xEE6B280000000000ULL,0x0000000000000000ULL,
+                            0x9502F90000000000ULL,0x0000000000000000ULL,0xBA43B74000000000ULL,0x0000000000000000ULL,
+                            0xE8D4A51000000000ULL,0x0000000000000000ULL,0x9184E72A00000000ULL,0x0000000000000000ULL,
+                            0xB5E620F480000000ULL,0x0000000000000000ULL,0xE35FA931A0000000ULL,0x0000000000000000ULL,
+                            0x8E1BC9BF04000000ULL,0x0000000000000000ULL,0xB1A2BC2EC5000000ULL,0x0000000000000000ULL,
+                            0xDE0B6B3A76400000ULL,0x0000000000000000ULL,0x8AC7230489E80000ULL,0x0000000000000000ULL,
+                            0xAD78EBC5AC620000ULL,0x0000000000000000ULL,0xD8D726B7177A8000ULL,0x0000000000000000ULL,
+                            0x878678326EAC9000ULL,0x0000000000000000ULL,0xA968163F0A57B400ULL,0x0000000000000000ULL,
+                            0xD3C21BCECCEDA100ULL,0x0000000000000000ULL,0x84595161401484A0ULL,0x0000000000000000ULL,
+                            0xA56FA5B99019A5C8ULL,0x0000000000000000ULL,0xCECB8F27F4200F3AULL,0x0000000000000000ULL,
+                            0x813F3978F8940984ULL,0x4000000000000000ULL,0xA18F07D736B90BE5ULL,0x5000000000000000ULL,
+                            0xC9F2C9CD04674EDEULL,0xA400000000000000ULL,0xFC6F7C4045812296ULL,0x4D00000000000000ULL,
+                            0x9DC5ADA82B70B59DULL,0xF020000000000000ULL,0xC5371912364CE305ULL,0x6C28000000000000ULL,
+                            0xF684DF56C3E01BC6ULL,0xC732000000000000ULL,0x9A130B963A6C115CULL,0x3C7F400000000000ULL,
+                            0xC097CE7BC90715B3ULL,0x4B9F100000000000ULL,0xF0BDC21ABB48DB20ULL,0x1E86D40000000000ULL,
+                            0x96769950B50D88F4ULL,0x1314448000000000ULL,0xBC143FA4E250EB31ULL,0x17D955A000000000ULL,
+                            0xEB194F8E1AE525FDULL,0x5DCFAB0800000000ULL,0x92EFD1B8D0CF37BEULL,0x5AA1CAE500000000ULL,
+                            0xB7ABC627050305ADULL,0xF14A3D9E40000000ULL,0xE596B7B0C643C719ULL,0x6D9CCD05D0000000ULL,
+                            0x8F7E32CE7BEA5C6FULL,0xE4820023A2000000ULL,0xB35DBF821AE4F38BULL,0xDDA2802C8A800000ULL,
+                            0xE0352F62A19E306EULL,0xD50B2037AD200000ULL,0x8C213D9DA502DE45ULL,0x4526F422CC340000ULL,
+                            0xAF298D050E4395D6ULL,0x9670B12B7F410000ULL,0xDAF3F04651D47B4CULL,0x3C0CDD765F114000ULL,
+                            0x88D8762BF324CD0FULL,0xA5880A69FB6AC800ULL,0xAB0E93B6EFEE0053ULL,0x8EEA0D047A457A00ULL,
+                            0xD5D238A4ABE98068ULL,0x72A4904598D6D880ULL,0x85A36366EB71F041ULL,0x47A6DA2B7F864750ULL,
+                            0xA70C3C40A64E6C51ULL,0x999090B65F67D924ULL,0xD0CF4B50CFE20765ULL,0xFFF4B4E3F741CF6DULL,
+                            0x82818F1281ED449FULL,0xBFF8F10E7A8921A4ULL,0xA321F2D7226895C7ULL,0xAFF72D52192B6A0DULL,
+                            0xCBEA6F8CEB02BB39ULL,0x9BF4F8A69F764490ULL,0xFEE50B7025C36A08ULL,0x02F236D04753D5B4ULL,
+                            0x9F4F2726179A2245ULL,0x01D762422C946590ULL,0xC722F0EF9D80AAD6ULL,0x424D3AD2B7B97EF5ULL,
+                            0xF8EBAD2B84E0D58BULL,0xD2E0898765A7DEB2ULL,0x9B934C3B330C8577ULL,0x63CC55F49F88EB2FULL,
+                            0xC2781F49FFCFA6D5ULL,0x3CBF6B71C76B25FBULL,0xF316271C7FC3908AULL,0x8BEF464E3945EF7AULL,
+                            0x97EDD871CFDA3A56ULL,0x97758BF0E3CBB5ACULL,0xBDE94E8E43D0C8ECULL,0x3D52EEED1CBEA317ULL,
+                            0xED63A231D4C4FB27ULL,0x4CA7AAA863EE4BDDULL,0x945E455F24FB1CF8ULL,0x8FE8CAA93E74EF6AULL,
+                            0xB975D6B6EE39E436ULL,0xB3E2FD538E122B44ULL,0xE7D34C64A9C85D44ULL,0x60DBBCA87196B616ULL,
+                            0x90E40FBEEA1D3A4AULL,0xBC8955E946FE31CDULL,0xB51D13AEA4A488DDULL,0x6BABAB6398BDBE41ULL,
+                            0xE264589A4DCDAB14ULL,0xC696963C7EED2DD1ULL,0x8D7EB76070A08AECULL,0xFC1E1DE5CF543CA2ULL,
+                            0xB0DE65388CC8ADA8ULL,0x3B25A55F43294BCBULL,0xDD15FE86AFFAD912ULL,0x49EF0EB713F39EBEULL,
+                            0x8A2DBF142DFCC7ABULL,0x6E3569326C784337ULL,0xACB92ED9397BF996ULL,0x49C2C37F07965404ULL,
+                            0xD7E77A8F87DAF7FBULL,0xDC33745EC97BE906ULL,0x86F0AC99B4E8DAFDULL,0x69A028BB3DED71A3ULL,
+                            0xA8ACD7C0222311BCULL,0xC40832EA0D68CE0CULL,0xD2D80DB02AABD62BULL,0xF50A3FA490C30190ULL,
+                            0x83C7088E1AAB65DBULL,0x792667C6DA79E0FAULL,0xA4B8CAB1A1563F52ULL,0x577001B891185938ULL,
+                            0xCDE6FD5E09ABCF26ULL,0xED4C0226B55E6F86ULL,0x80B05E5AC60B6178ULL,0x544F8158315B05B4ULL,
+                            0xA0DC75F1778E39D6ULL,0x696361AE3DB1C721ULL,0xC913936DD571C84CULL,0x03BC3A19CD1E38E9ULL,
+                            0xFB5878494ACE3A5FULL,0x04AB48A04065C723ULL,0x9D174B2DCEC0E47BULL,0x62EB0D64283F9C76ULL,
+                            0xC45D1DF942711D9AULL,0x3BA5D0BD324F8394ULL,0xF5746577930D6500ULL,0xCA8F44EC7EE36479ULL,
+                            0x9968BF6ABBE85F20ULL,0x7E998B13CF4E1ECBULL,0xBFC2EF456AE276E8ULL,0x9E3FEDD8C321A67EULL,
+                            0xEFB3AB16C59B14A2ULL,0xC5CFE94EF3EA101EULL,0x95D04AEE3B80ECE5ULL,0xBBA1F1D158724A12ULL,
+                            0xBB445DA9CA61281FULL,0x2A8A6E45AE8EDC97ULL,0xEA1575143CF97226ULL,0xF52D09D71A3293BDULL,
+                            0x924D692CA61BE758ULL,0x593C2626705F9C56ULL,0xB6E0C377CFA2E12EULL,0x6F8B2FB00C77836CULL,
+                            0xE498F455C38B997AULL,0x0B6DFB9C0F956447ULL,0x8EDF98B59A373FECULL,0x4724BD4189BD5EACULL,
+                            0xB2977EE300C50FE7ULL,0x58EDEC91EC2CB657ULL,0xDF3D5E9BC0F653E1ULL,0x2F2967B66737E3EDULL,
+                            0x8B865B215899F46CULL,0xBD79E0D20082EE74ULL,0xAE67F1E9AEC07187ULL,0xECD8590680A3AA11ULL,
+                            0xDA01EE641A708DE9ULL,0xE80E6F4820CC9495ULL,0x884134FE908658B2ULL,0x3109058D147FDCDDULL,
+                            0xAA51823E34A7EEDEULL,0xBD4B46F0599FD415ULL,0xD4E5E2CDC1D1EA96ULL,0x6C9E18AC7007C91AULL,
+                            0x850FADC09923329EULL,0x03E2CF6BC604DDB0ULL,0xA6539930BF6BFF45ULL,0x84DB8346B786151CULL,
+                            0xCFE87F7CEF46FF16ULL,0xE612641865679A63ULL,0x81F14FAE158C5F6EULL,0x4FCB7E8F3F60C07EULL,
+                            0xA26DA3999AEF7749ULL,0xE3BE5E330F38F09DULL,0xCB090C8001AB551CULL,0x5CADF5BFD3072CC5ULL,
+                            0xFDCB4FA002162A63ULL,0x73D9732FC7C8F7F6ULL,0x9E9F11C4014DDA7EULL,0x2867E7FDDCDD9AFAULL,
+                            0xC646D63501A1511DULL,0xB281E1FD541501B8ULL,0xF7D88BC24209A565ULL,0x1F225A7CA91A4226ULL,
+                            0x9AE757596946075FULL,0x3375788DE9B06958ULL,0xC1A12D2FC3978937ULL,0x0052D6B1641C83AEULL,
+                            0xF209787BB47D6B84ULL,0xC0678C5DBD23A49AULL,0x9745EB4D50CE6332ULL,0xF840B7BA963646E0ULL,
+                            0xBD176620A501FBFFULL,0xB650E5A93BC3D898ULL,0xEC5D3FA8CE427AFFULL,0xA3E51F138AB4CEBEULL,
+                            0x93BA47C980E98CDFULL,0xC66F336C36B10137ULL,0xB8A8D9BBE123F017ULL,0xB80B0047445D4184ULL,
+                            0xE6D3102AD96CEC1DULL,0xA60DC059157491E5ULL,0x9043EA1AC7E41392ULL,0x87C89837AD68DB2FULL,
+                            0xB454E4A179DD1877ULL,0x29BABE4598C311FBULL,0xE16A1DC9D8545E94ULL,0xF4296DD6FEF3D67AULL,
+                            0x8CE2529E2734BB1DULL,0x1899E4A65F58660CULL,0xB01AE745B101E9E4ULL,0x5EC05DCFF72E7F8FULL,
+                            0xDC21A1171D42645DULL,0x76707543F4FA1F73ULL,0x899504AE72497EBAULL,0x6A06494A791C53A8ULL,
+                            0xABFA45DA0EDBDE69ULL,0x0487DB9D17636892ULL,0xD6F8D7509292D603ULL,0x45A9D2845D3C42B6ULL,
+                            0x865B86925B9BC5C2ULL,0x0B8A2392BA45A9B2ULL,0xA7F26836F282B732ULL,0x8E6CAC7768D7141EULL,
+                            0xD1EF0244AF2364FFULL,0x3207D795430CD926ULL,0x8335616AED761F1FULL,0x7F44E6BD49E807B8ULL,
+                            0xA402B9C5A8D3A6E7ULL,0x5F16206C9C6209A6ULL,0xCD036837130890A1ULL,0x36DBA887C37A8C0FULL,
+                            0x802221226BE55A64ULL,0xC2494954DA2C9789ULL,0xA02AA96B06DEB0FDULL,0xF2DB9BAA10B7BD6CULL,
+                            0xC83553C5C8965D3DULL,0x6F92829494E5ACC7ULL,0xFA42A8B73ABBF48CULL,0xCB772339BA1F17F9ULL,
+                            0x9C69A97284B578D7ULL,0xFF2A760414536EFBULL,0xC38413CF25E2D70DULL,0xFEF5138519684ABAULL,
+                            0xF46518C2EF5B8CD1ULL,0x7EB258665FC25D69ULL,0x98BF2F79D5993802ULL,0xEF2F773FFBD97A61ULL,
+                            0xBEEEFB584AFF8603ULL,0xAAFB550FFACFD8FAULL,0xEEAABA2E5DBF6784ULL,0x95BA2A53F983CF38ULL,
+                            0x952AB45CFA97A0B2ULL,0xDD945A747BF26183ULL,0xBA756174393D88DFULL,0x94F971119AEEF9E4ULL,
+                            0xE912B9D1478CEB17ULL,0x7A37CD5601AAB85DULL,0x91ABB422CCB812EEULL,0xAC62E055C10AB33AULL,
+                            0xB616A12B7FE617AAULL,0x577B986B314D6009ULL,0xE39C49765FDF9D94ULL,0xED5A7E85FDA0B80BULL,
+                            0x8E41ADE9FBEBC27DULL,0x14588F13BE847307ULL,0xB1D219647AE6B31CULL,0x596EB2D8AE258FC8ULL,
+                            0xDE469FBD99A05FE3ULL,0x6FCA5F8ED9AEF3BBULL,0x8AEC23D680043BEEULL,0x25DE7BB9480D5854ULL,
+                            0xADA72CCC20054AE9ULL,0xAF561AA79A10AE6AULL,0xD910F7FF28069DA4ULL,0x1B2BA1518094DA04ULL,
+                            0x87AA9AFF79042286ULL,0x90FB44D2F05D0842ULL,0xA99541BF57452B28ULL,0x353A1607AC744A53ULL,
+                            0xD3FA922F2D1675F2ULL,0x42889B8997915CE8ULL,0x847C9B5D7C2E09B7ULL,0x69956135FEBADA11ULL,
+                            0xA59BC234DB398C25ULL,0x43FAB9837E699095ULL,0xCF02B2C21207EF2EULL,0x94F967E45E03F4BBULL,
+                            0x8161AFB94B44F57DULL,0x1D1BE0EEBAC278F5ULL,0xA1BA1BA79E1632DCULL,0x6462D92A69731732ULL,
+                            0xCA28A291859BBF93ULL,0x7D7B8F7503CFDCFEULL,0xFCB2CB35E702AF78ULL,0x5CDA735244C3D43EULL,
+                            0x9DEFBF01B061ADABULL,0x3A0888136AFA64A7ULL,0xC56BAEC21C7A1916ULL,0x088AAA1845B8FDD0ULL,
+                            0xF6C69A72A3989F5BULL,0x8AAD549E57273D45ULL,0x9A3C2087A63F6399ULL,0x36AC54E2F678864BULL,
+                            0xC0CB28A98FCF3C7FULL,0x84576A1BB416A7DDULL,0xF0FDF2D3F3C30B9FULL,0x656D44A2A11C51D5ULL,
+                            0x969EB7C47859E743ULL,0x9F644AE5A4B1B325ULL,0xBC4665B596706114ULL,0x873D5D9F0DDE1FEEULL,
+                            0xEB57FF22FC0C7959ULL,0xA90CB506D155A7EAULL,0x9316FF75DD87CBD8ULL,0x09A7F12442D588F2ULL,
+                            0xB7DCBF5354E9BECEULL,0x0C11ED6D538AEB2FULL,0xE5D3EF282A242E81ULL,0x8F1668C8A86DA5FAULL,
+                            0x8FA475791A569D10ULL,0xF96E017D694487BCULL,0xB38D92D760EC4455ULL,0x37C981DCC395A9ACULL,
+                            0xE070F78D3927556AULL,0x85BBE253F47B1417ULL,0x8C469AB843B89562ULL,0x93956D7478CCEC8EULL,
+                            0xAF58416654A6BABBULL,0x387AC8D1970027B2ULL,0xDB2E51BFE9D0696AULL,0x06997B05FCC0319EULL,
+                            0x88FCF317F22241E2ULL,0x441FECE3BDF81F03ULL,0xAB3C2FDDEEAAD25AULL,0xD527E81CAD7626C3ULL,
+                            0xD60B3BD56A5586F1ULL,0x8A71E223D8D3B074ULL,0x85C7056562757456ULL,0xF6872D5667844E49ULL,
+                            0xA738C6BEBB12D16CULL,0xB428F8AC016561DBULL,0xD106F86E69D785C7ULL,0xE13336D701BEBA52ULL,
+                            0x82A45B450226B39CULL,0xECC0024661173473ULL,0xA34D721642B06084ULL,0x27F002D7F95D0190ULL,
+                            0xCC20CE9BD35C78A5ULL,0x31EC038DF7B441F4ULL,0xFF290242C83396CEULL,0x7E67047175A15271ULL,
+                            0x9F79A169BD203E41ULL,0x0F0062C6E984D386ULL,0xC75809C42C684DD1ULL,0x52C07B78A3E60868ULL,
+                            0xF92E0C3537826145ULL,0xA7709A56CCDF8A82ULL,0x9BBCC7A142B17CCBULL,0x88A66076400BB691ULL,
+                            0xC2ABF989935DDBFEULL,0x6ACFF893D00EA435ULL,0xF356F7EBF83552FEULL,0x0583F6B8C4124D43ULL,
+                            0x98165AF37B2153DEULL,0xC3727A337A8B704AULL,0xBE1BF1B059E9A8D6ULL,0x744F18C0592E4C5CULL,
+                            0xEDA2EE1C7064130CULL,0x1162DEF06F79DF73ULL,0x9485D4D1C63E8BE7ULL,0x8ADDCB5645AC2BA8ULL,
+                            0xB9A74A0637CE2EE1ULL,0x6D953E2BD7173692ULL,0xE8111C87C5C1BA99ULL,0xC8FA8DB6CCDD0437ULL,
+                            0x910AB1D4DB9914A0ULL,0x1D9C9892400A22A2ULL,0xB54D5E4A127F59C8ULL,0x2503BEB6D00CAB4BULL,
+                            0xE2A0B5DC971F303AULL,0x2E44AE64840FD61DULL,0x8DA471A9DE737E24ULL,0x5CEAECFED289E5D2ULL,
+                            0xB10D8E1456105DADULL,0x7425A83E872C5F47ULL,0xDD50F1996B947518ULL,0xD12F124E28F77719ULL,
+                            0x8A5296FFE33CC92FULL,0x82BD6B70D99AAA6FULL,0xACE73CBFDC0BFB7BULL,0x636CC64D1001550BULL,
+                            0xD8210BEFD30EFA5AULL,0x3C47F7E05401AA4EULL,0x8714A775E3E95C78ULL,0x65ACFAEC34810A71ULL,
+                            0xA8D9D1535CE3B396ULL,0x7F1839A741A14D0DULL,0xD31045A8341CA07CULL,0x1EDE48111209A050ULL,
+                            0x83EA2B892091E44DULL,0x934AED0AAB460432ULL,0xA4E4B66B68B65D60ULL,0xF81DA84D5617853FULL,
+                            0xCE1DE40642E3F4B9ULL,0x36251260AB9D668EULL,0x80D2AE83E9CE78F3ULL,0xC1D72B7C6B426019ULL,
+                            0xA1075A24E4421730ULL,0xB24CF65B8612F81FULL,0xC94930AE1D529CFCULL,0xDEE033F26797B627ULL,
+                            0xFB9B7CD9A4A7443CULL,0x169840EF017DA3B1ULL,0x9D412E0806E88AA5ULL,0x8E1F289560EE864EULL,
+                            0xC491798A08A2AD4EULL,0xF1A6F2BAB92A27E2ULL,0xF5B5D7EC8ACB58A2ULL,0xAE10AF696774B1DBULL,
+                            0x9991A6F3D6BF1765ULL,0xACCA6DA1E0A8EF29ULL,0xBFF610B0CC6EDD3FULL,0x17FD090A58D32AF3ULL,
+                            0xEFF394DCFF8A948EULL,0xDDFC4B4CEF07F5B0ULL,0x95F83D0A1FB69CD9ULL,0x4ABDAF101564F98EULL,
+                            0xBB764C4CA7A4440FULL,0x9D6D1AD41ABE37F1ULL,0xEA53DF5FD18D5513ULL,0x84C86189216DC5EDULL,
+                            0x92746B9BE2F8552CULL,0x32FD3CF5B4E49BB4ULL,0xB7118682DBB66A77ULL,0x3FBC8C33221DC2A1ULL,
+                            0xE4D5E82392A40515ULL,0x0FABAF3FEAA5334AULL,0x8F05B1163BA6832DULL,0x29CB4D87F2A7400EULL,
+                            0xB2C71D5BCA9023F8ULL,0x743E20E9EF511012ULL,0xDF78E4B2BD342CF6ULL,0x914DA9246B255416ULL,
+                            0x8BAB8EEFB6409C1AULL,0x1AD089B6C2F7548EULL,0xAE9672ABA3D0C320ULL,0xA184AC2473B529B1ULL,
+                            0xDA3C0F568CC4F3E8ULL,0xC9E5D72D90A2741EULL,0x8865899617FB1871ULL,0x7E2FA67C7A658892ULL,
+                            0xAA7EEBFB9DF9DE8DULL,0xDDBB901B98FEEAB7ULL,0xD51EA6FA85785631ULL,0x552A74227F3EA565ULL,
+                            0x8533285C936B35DEULL,0xD53A88958F87275FULL,0xA67FF273B8460356ULL,0x8A892ABAF368F137ULL,
+                            0xD01FEF10A657842CULL,0x2D2B7569B0432D85ULL,0x8213F56A67F6B29BULL,0x9C3B29620E29FC73ULL,
+                            0xA298F2C501F45F42ULL,0x8349F3BA91B47B8FULL,0xCB3F2F7642717713ULL,0x241C70A936219A73ULL,
+                            0xFE0EFB53D30DD4D7ULL,0xED238CD383AA0110ULL,0x9EC95D1463E8A506ULL,0xF4363804324A40AAULL,
+                            0xC67BB4597CE2CE48ULL,0xB143C6053EDCD0D5ULL,0xF81AA16FDC1B81DAULL,0xDD94B7868E94050AULL,
+                            0x9B10A4E5E9913128ULL,0xCA7CF2B4191C8326ULL,0xC1D4CE1F63F57D72ULL,0xFD1C2F611F63A3F0ULL,
+                            0xF24A01A73CF2DCCFULL,0xBC633B39673C8CECULL,0x976E41088617CA01ULL,0xD5BE0503E085D813ULL,
+                            0xBD49D14AA79DBC82ULL,0x4B2D8644D8A74E18ULL,0xEC9C459D51852BA2ULL,0xDDF8E7D60ED1219EULL,
+                            0x93E1AB8252F33B45ULL,0xCABB90E5C942B503ULL,0xB8DA1662E7B00A17ULL,0x3D6A751F3B936243ULL,
+                            0xE7109BFBA19C0C9DULL,0x0CC512670A783AD4ULL,0x906A617D450187E2ULL,0x27FB2B80668B24C5ULL,
+                            0xB484F9DC9641E9DAULL,0xB1F9F660802DEDF6ULL,0xE1A63853BBD26451ULL,0x5E7873F8A0396973ULL,
+                            0x8D07E33455637EB2ULL,0xDB0B487B6423E1E8ULL,0xB049DC016ABC5E5FULL,0x91CE1A9A3D2CDA62ULL,
+                            0xDC5C5301C56B75F7ULL,0x7641A140CC7810FBULL,0x89B9B3E11B6329BAULL,0xA9E904C87FCB0A9DULL,
+                            0xAC2820D9623BF429ULL,0x546345FA9FBDCD44ULL,0xD732290FBACAF133ULL,0xA97C177947AD4095ULL,
+                            0x867F59A9D4BED6C0ULL,0x49ED8EABCCCC485DULL,0xA81F301449EE8C70ULL,0x5C68F256BFFF5A74ULL,
+                            0xD226FC195C6A2F8CULL,0x73832EEC6FFF3111ULL,0x83585D8FD9C25DB7ULL,0xC831FD53C5FF7EABULL,
+                            0xA42E74F3D032F525ULL,0xBA3E7CA8B77F5E55ULL,0xCD3A1230C43FB26FULL,0x28CE1BD2E55F35EBULL,
+                            0x80444B5E7AA7CF85ULL,0x7980D163CF5B81B3ULL,0xA0555E361951C366ULL,0xD7E105BCC332621FULL,
+                            0xC86AB5C39FA63440ULL,0x8DD9472BF3FEFAA7ULL,0xFA856334878FC150ULL,0xB14F98F6F0FEB951ULL,
+                            0x9C935E00D4B9D8D2ULL,0x6ED1BF9A569F33D3ULL,0xC3B8358109E84F07ULL,0x0A862F80EC4700C8ULL,
+                            0xF4A642E14C6262C8ULL,0xCD27BB612758C0FAULL,0x98E7E9CCCFBD7DBDULL,0x8038D51CB897789CULL,
+                            0xBF21E44003ACDD2CULL,0xE0470A63E6BD56C3ULL,0xEEEA5D5004981478ULL,0x1858CCFCE06CAC74ULL,
+                            0x95527A5202DF0CCBULL,0x0F37801E0C43EBC8ULL,0xBAA718E68396CFFDULL,0xD30560258F54E6BAULL,
+                            0xE950DF20247C83FDULL,0x47C6B82EF32A2069ULL,0x91D28B7416CDD27EULL,0x4CDC331D57FA5441ULL,
+                            0xB6472E511C81471DULL,0xE0133FE4ADF8E952ULL,0xE3D8F9E563A198E5ULL,0x58180FDDD97723A6ULL,
+                            0x8E679C2F5E44FF8FULL,0x570F09EAA7EA7648ULL
+                         };
+            return table;
+         }
+
+         static const int smallest_power_of_five = -342;
+         static const int largest_power_of_five  =  308;
+
+         inline void full_multiply(const unsigned long long int a, const unsigned long long int b,
+                                   unsigned long long int& hi, unsigned long long int& lo)
+         {
+            #if defined(__GNUC__) && defined(__SIZEOF_INT128__)
+               __extension__ typedef unsigned __int128 uint128_type;
+               const uint128_type r = static_cast<uint128_type>(a) * b;
+               hi = static_cast<unsigned long long int>(r >> 64);
+               lo = static_cast<unsigned long long int>(r);
+            #else
+               const unsigned long long int mask = 0xFFFFFFFFULL;
+               const unsigned long long int ll = (a & mask) * (b & mask);
+               const unsigned long long int lh = (a & mask) * (b >> 32);
+               const unsigned long long int hl = (a >> 32) * (b & mask);
+               const unsigned long long int hh = (a >> 32) * (b >> 32);
+               const unsigned long long int mid = (ll >> 32) + (lh & mask) + (hl & mask);
+               lo = (mid << 32) | (ll & mask);
+               hi = hh + (lh >> 32) + (hl >> 32) + (mid >> 32);
+            #endif
+         }
+
+         inline int leading_zeros(unsigned long long int x)
+         {
+            #if defined(__GNUC__)
+               return __builtin_clzll(x);
+            #else
+               int n = 0;
+               if (0 == (x & 0xFFFFFFFF00000000ULL)) { n += 32; x <<= 32; }
+               if (0 == (x & 0xFFFF000000000000ULL)) { n += 16; x <<= 16; }
+               if (0 == (x & 0xFF00000000000000ULL)) { n +=  8; x <<=  8; }
+               if (0 == (x & 0xF000000000000000ULL)) { n +=  4; x <<=  4; }
+               if (0 == (x & 0xC000000000000000ULL)) { n +=  2; x <<=  2; }
+               if (0 == (x & 0x8000000000000000ULL)) { n +=  1; }
+               return n;
+            #endif
+         }
+
+         inline double make_double(const unsigned long long int mantissa, const int power2, const bool negative)
+         {
+            unsigned long long int bits = mantissa | (static_cast<unsigned long long int>(power2) << 52);
+            if (negative)
+               bits |= 0x8000000000000000ULL;
+            double d = 0.0;
+            std::memcpy(&d,&bits,sizeof(d));
+            return d;
+         }
+
+         // w * 10^q rounded to the nearest double (Eisel-Lemire), for w != 0 and q in the power of five
+         // table. Multiplying the normalized w by the 128-bit 5^q leaves the 54 bits we need at the top;
+         // if the bits under them are all ones the truncated table could have moved them, so the next 64
+         // bits of 5^q get added in. False on the very rare products that still can't be settled.
+         inline bool eisel_lemire(unsigned long long int w, const int q, const bool negative, double& d)
+         {
+            const int lz = leading_zeros(w);
+            w <<= lz;
+
+            const unsigned long long int* power = power_of_five_128() + 2 * (q - smallest_power_of_five);
+            unsigned long long int hi = 0;
+            unsigned long long int lo = 0;
+            full_multiply(w,power[0],hi,lo);
+
+            if (0x1FF == (hi & 0x1FF))
+            {
+               unsigned long long int hi2 = 0;
+               unsigned long long int lo2 = 0;
+               full_multiply(w,power[1],hi2,lo2);
+               lo += hi2;
+               if (hi2 > lo)
+                  ++hi;
+               if ((0x1FF == (hi & 0x1FF)) && (0xFFFFFFFFFFFFFFFFULL == lo))
+                  return false;
+            }
+
+            const int upper_bit = static_cast<int>(hi >> 63);
+            unsigned long long int mantissa = hi >> (upper_bit + 9);
+            // floor(q * log2(10)) + 63, plus the exponent bias
+            int power2 = (((152170 + 65536) * q) >> 16) + 63 + upper_bit - lz + 1023;
+
+            if (power2 <= 0)
+            {
+               // Subnormal, shift down to the fixed exponent and round once
+               if ((-power2 + 1) >= 64)
+               {
+                  d = make_double(0,0,negative);
+                  return true;
+               }
+               mantissa >>= (-power2 + 1);
+               mantissa += (mantissa & 1);
+               mantissa >>= 1;
+               power2 = (mantissa < (1ULL << 52)) ? 0 : 1;
+               d = make_double(mantissa & ~(1ULL << 52),power2,negative);
+               return true;
+            }
+
+            // Only small q can land exactly halfway between two doubles, those round to even
+            if ((lo <= 1) && (q >= -4) && (q <= 23) && (1 == (mantissa & 3)) &&
+                ((mantissa << (upper_bit + 9)) == hi))
+            {
+               mantissa &= ~1ULL;
+            }
+
+            mantissa += (mantissa & 1);
+            mantissa >>= 1;
+            if (mantissa >= (2ULL << 52))
+            {
+               mantissa = (1ULL << 52);
+               ++power2;
+            }
+            mantissa &= ~(1ULL << 52);
+
+            if (power2 >= 0x7FF)
+            {
+               mantissa = 0;
+               power2 = 0x7FF;
+            }
+
+            d = make_double(mantissa,power2,negative);
+            return true;
+         }
+
+         // w * 10^q to the nearest double. Exactly, straight from the FPU, when w and 10^|q| are both
+         // exact doubles, otherwise by Eisel-Lemire. False when Eisel-Lemire can't settle it.
+         inline bool decimal_to_double(const unsigned long long int w, const int q, const bool negative, double& d)
+         {
+            if ((0 == w) || (q < smallest_power_of_five))
+            {
+               d = make_double(0,0,negative);
+               return true;
+            }
+            else if (q > largest_power_of_five)
+            {
+               d = make_double(0,0x7FF,negative);
+               return true;
+            }
+            #if !(defined(__i386__) && !defined(__SSE2_MATH__)) // x87 rounds to extended precision first
+            else if ((-22 <= q) && (q <= 22) && (w <= (1ULL << 53)))
+            {
+               static const double exact_power10[] =
+                            {
+                               1.0E+000, 1.0E+001, 1.0E+002, 1.0E+003, 1.0E+004, 1.0E+005, 1.0E+006, 1.0E+007,
+                               1.0E+008, 1.0E+009, 1.0E+010, 1.0E+011, 1.0E+012, 1.0E+013, 1.0E+014, 1.0E+015,
+                               1.0E+016, 1.0E+017, 1.0E+018, 1.0E+019, 1.0E+020, 1.0E+021, 1.0E+022
+                            };
+               d = static_cast<double>(w);
+               if (q < 0)
+                  d /= exact_power10[-q];
+               else
+                  d *= exact_power10[q];
+               if (negative)
+                  d = -d;
+               return true;
+            }
+            #endif
+            else
+               return eisel_lemire(w,q,negative,d);
+         }
+
+         template <typename Iterator>
+         inline bool strtod_convert(const Iterator begin, const Iterator end, double& t)
+         {
+            const std::string s(begin,end);
+            char* s_end = 0;
+            const double d = std::strtod(s.c_str(),&s_end);
+            if ((s.c_str() + s.size()) != s_end)
+               return false;
+            else if ((d > std::numeric_limits<double>::max()) || (d < -std::numeric_limits<double>::max()))
+               return false;
+            t = d;
+            return true;
+         }
+
+         // More than 19 significant digits overflow w, so go over the mantissa again taking just
+         // the first 19. If any that got cut off weren't zeros, the answer's only settled if w and
+         // w + 1 round to the same double, otherwise it's down to strtod.
+         template <typename Iterator>
+         inline bool long_real_convert(const Iterator begin, const Iterator end, int exponent, const bool negative, double& t)
+         {
+            static const unsigned long long int nineteen_digits = 1000000000000000000ULL;
+            unsigned long long int w = 0;
+            bool truncated = false;
+            unsigned char digit = 0;
+            Iterator itr = begin;
+
+            if (('+' == (*itr)) || ('-' == (*itr)))
+               ++itr;
+            while ((end != itr) && ('0' == (*itr))) ++itr;
+            while ((end != itr) && ((digit = static_cast<unsigned char>((*itr) - '0')) < 10))
+            {
+               if (w < nineteen_digits)
+                  w = (w * 10) + digit;
+               else
+               {
+                  ++exponent;
+                  truncated |= (0 != digit);
+               }
+               ++itr;
+            }
+
+            if ((end != itr) && ('.' == (*itr)))
+            {
+               ++itr;
+               while ((end != itr) && ((digit = static_cast<unsigned char>((*itr) - '0')) < 10))
+               {
+                  if (w < nineteen_digits)
+                  {
+                     w = (w * 10) + digit;
+                     --exponent;
+                  }
+                  else
+                     truncated |= (0 != digit);
+                  ++itr;
+               }
+            }
+
+            double d = 0.0;
+            double d_upper = 0.0;
+            if (!decimal_to_double(w,exponent,negative,d))
+               return strtod_convert(begin,end,t);
+            else if (truncated && !(decimal_to_double(w + 1,exponent,negative,d_upper) && (d == d_upper)))
+               return strtod_convert(begin,end,t);
+            else if ((d > std::numeric_limits<double>::max()) || (d < -std::numeric_limits<double>::max()))
+               return false;
+            t = d;
+            return true;
+         }
+      }
+
+      /*
+        Decimal to double, correctly rounded, for [+|-]digits[.digits][(e|E)[+|-]digits] with
+        digits on at least one side of the point. Up to 19 significant digits are converted
+        straight from a 64-bit integer. Longer ones are cut to 19, and if rounding the cut
+        value and the cut value plus one give the same double, that's the answer. Whatever
+        that can't settle falls back to strtod. Returns false for anything else, and for
+        values too big for a double.
+      */
+      template <typename Iterator>
+      inline bool real_convert(Iterator begin, const Iterator end, double& t)
+      {
+         const Iterator start = begin;
+         if (end == begin)
+            return false;
+
+         bool negative = false;
+         if ('+' == (*begin))
+            ++begin;
+         else if ('-' == (*begin))
+         {
+            ++begin;
+            negative = true;
+         }
+
+         // Take every significant digit first and only look closer if there turn out to be more than 19
+         const Iterator mantissa_begin = begin;
+         while ((end != begin) && ('0' == (*begin))) ++begin;
+         Iterator digits_begin = begin;
+         unsigned long long int w = 0;
+         unsigned char digit = 0;
+         while ((end != begin) && ((digit = static_cast<unsigned char>((*begin) - '0')) < 10))
+         {
+            w = (w * 10) + digit;
+            ++begin;
+         }
+
+         int digit_count = static_cast<int>(std::distance(digits_begin,begin));
+         int fraction_digits = 0;
+         bool point = false;
+
+         if ((end != begin) && ('.' == (*begin)))
+         {
+            ++begin;
+            point = true;
+            const Iterator fraction_begin = begin;
+            // Zeros straight after the point aren't significant if nothing came before them
+            if (0 == digit_count)
+            {
+               while ((end != begin) && ('0' == (*begin))) ++begin;
+            }
+            digits_begin = begin;
+            while ((end != begin) && ((digit = static_cast<unsigned char>((*begin) - '0')) < 10))
+            {
+               w = (w * 10) + digit;
+               ++begin;
+            }
+            fraction_digits = static_cast<int>(std::distance(fraction_begin,begin));
+            digit_count += static_cast<int>(std::distance(digits_begin,begin));
+         }
+
+         // Nothing but a sign and maybe a point
+         if (std::distance(mantissa_begin,begin) == (point ? 1 : 0))
+            return false;
+
+         int exponent = 0;
+
+         if ((end != begin) && (('e' == (*begin)) || ('E' == (*begin))))
+         {
+            ++begin;
+            bool negative_exp = false;
+            if ((end != begin) && ('+' == (*begin)))
+               ++begin;
+            else if ((end != begin) && ('-' == (*begin)))
+            {
+               ++begin;
+               negative_exp = true;
+            }
+            if (end == begin)
+               return false;
+            int exp = 0;
+            while ((end != begin) && ((digit = static_cast<unsigned char>((*begin) - '0')) < 10))
+            {
+               if (exp < 100000)
+                  exp = (exp * 10) + digit;
+               ++begin;
+            }
+            exponent = negative_exp ? -exp : exp;
+         }
+
+         if (end != begin)
+            return false;
+
+         // The rare cases go off to do the whole job themselves, keeping this path short
+         if (digit_count > 19)
+            return details::long_real_convert(start,end,exponent,negative,t);
+
+         double d = 0.0;
+         if (!details::decimal_to_double(w,exponent - fraction_digits,negative,d))
+            return details::strtod_convert(start,end,t);
+         else if ((d > std::numeric_limits<double>::max()) || (d < -std::numeric_limits<double>::max()))
+            return false;
+
+         t = d;
+         return true;
+      }
+
+      inline bool real_convert(const std::string& s, double& t)
+      {
+         return real_convert(s.data(),s.data() + s.size(),t);
+      }
+
    } // namespace fast
 
    namespace binary
@@ -16695,6 +19331,16 @@ namespace strtk
          return true;
       }
 
+      // Plain decimals go through the correctly rounded fast::real_convert, the rest (inf, nan,
+      // suffixes and the like) through the general real conversion above
+      template <typename Iterator>
+      inline bool string_to_type_converter_impl(Iterator& itr, const Iterator end, double& t, real_type_tag)
+      {
+         if (fast::real_convert(itr,end,t))
+            return true;
+         return string_to_type_converter_impl<Iterator,double>(itr,end,t,real_type_tag());
+      }
+
       template <typename Iterator, typename T>
       inline bool string_to_type_converter_impl(Iterator& itr, const Iterator end, T& t, byte_type_tag)
       {
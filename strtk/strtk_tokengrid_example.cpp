@@ -28,6 +28,8 @@
 */
 
 
+#include <cstdio>
+#include <fstream>
 #include <iostream>
 #include <iterator>
 #include <algorithm>
@@ -830,6 +832,240 @@ void token_grid_test15()
    }
 }
 
+void token_grid_test16()
+{
+   // Same as loading from a file normally, except the file gets mapped into memory rather than copied
+   const std::string file_name = "token_grid_test16.txt";
+   {
+      std::ofstream stream(file_name.c_str());
+      stream << "1,2,3,4,5\n"
+                "6,7,8,9,10\n"
+                "11,12,13,14,15\n";
+   }
+
+   strtk::token_grid::options options;
+   options.set_column_delimiters(",");
+   options.set_memory_map(true);
+
+   {
+      strtk::token_grid grid(file_name,options);
+
+      for (std::size_t r = 0; r < grid.row_count(); ++r)
+      {
+         double sum = 0.0;
+         grid.accumulate_row(r,sum);
+         std::cout << "sum(row[" << r << "]) = " << sum << std::endl;
+      }
+   }
+
+   std::remove(file_name.c_str());
+}
+
+void token_grid_test17()
+{
+   // Rows read through a window smaller than most rows, so they keep running off its end
+   const std::string file_name = "token_grid_test17.txt";
+   {
+      std::ofstream stream(file_name.c_str());
+      stream << "Sidney Crosby,PIT,36,15,41,56\n"
+                "Patrick Kane,CHI,47,23,32,55\n"
+                "Martin St. Louis,TBL,48,17,43,60\n";
+   }
+
+   strtk::token_grid::options options;
+   options.set_column_delimiters(",");
+
+   strtk::token_grid::row_cursor cursor(file_name,options,16);
+
+   while (cursor.next())
+   {
+      std::string name;
+      std::string team;
+      int gp = 0;
+      int goals = 0;
+      int assists = 0;
+      int points = 0;
+      cursor.row().parse(name,team,gp,goals,assists,points);
+      std::cout << name << " (" << team << ") " << points << "pts in " << gp << "gp" << std::endl;
+   }
+
+   std::remove(file_name.c_str());
+}
+
+void token_grid_test18()
+{
+   // The second load finds the index the first one left next to the file and maps it in
+   const std::string file_name = "token_grid_test18.txt";
+   {
+      std::ofstream stream(file_name.c_str());
+      stream << "Alex Ovechkin,WSH,60,51,28\n"
+                "Steven Stamkos,TBL,60,32,28\n"
+                "Corey Perry,ANA,60,30,24\n";
+   }
+
+   strtk::token_grid::options options;
+   options.set_column_delimiters(",");
+   options.set_index_file(true);
+
+   for (int load = 0; load < 2; ++load)
+   {
+      strtk::token_grid grid(file_name,options);
+      std::cout << "load " << load << ": " << grid.row_count() << " rows, "
+                << grid.index_bytes_per_token() << " index bytes per token, "
+                << "goals(row[2]) = " << grid.get<int>(2,3) << std::endl;
+   }
+
+   std::remove(file_name.c_str());
+   std::remove((file_name + ".idx").c_str());
+}
+
+void token_grid_test19()
+{
+   // Typed columns out of the grid in one go, with the gaps and the junk marked rather than guessed at
+   std::string data = "Player,Team,GP,PTS,PCT\n"
+                      "Alex Ovechkin,WSH,78,79,15.3\n"
+                      "Steven Stamkos,TBL,82,97,\n"
+                      "Corey Perry,ANA,n/a,98,12.9\n"
+                      "Daniel Sedin,VAN,82,104,14.1\n";
+
+   strtk::token_grid::options options;
+   options.set_column_delimiters(",");
+   options.set_column_split_option(strtk::split_options::default_mode);
+
+   strtk::token_grid grid(data,data.size(),options);
+
+   strtk::token_grid::column_schema schema;
+   schema.add_string("player").add_int("gp").add_int("pts").add_double("pct");
+
+   strtk::token_grid::column_table table;
+   if (!grid.to_columns(schema,table))
+   {
+      std::cout << "token_grid_test19() - missing column" << std::endl;
+      return;
+   }
+
+   for (std::size_t r = 0; r < table.row_count(); ++r)
+   {
+      std::cout << table.string(table.string_ids(0)[r]) << " gp: ";
+      if (table.is_error(1,r))
+         std::cout << "error";
+      else
+         std::cout << table.ints(1)[r];
+      std::cout << " pts: " << table.ints(2)[r] << " pct: ";
+      if (table.is_null(3,r))
+         std::cout << "null";
+      else
+         std::cout << table.doubles(3)[r];
+      std::cout << std::endl;
+   }
+}
+
+struct skater_line
+{
+   std::string name;
+   std::string team;
+   int gp;
+   int pts;
+   int pim;
+};
+
+strtk_bind_begin(skater_line)
+   strtk_bind_column_at(name,"name|player",0)
+   strtk_bind_column_at(team,"team|tm",1)
+   strtk_bind_column_at(gp,"gp|games",2)
+   strtk_bind_column_at(pts,"pts|points",3)
+   strtk_bind_optional (pim,"pim")
+strtk_bind_end()
+
+void token_grid_test20()
+{
+   // The same struct filled from a file with a header (any column order) and from one without
+   const std::string with_header = "GP, Player ,PTS,Tm\n"
+                                   "78,Alex Ovechkin,79,WSH\n"
+                                   "82,Steven Stamkos,97,TBL\n";
+   const std::string without_header = "Corey Perry,ANA,82,98\n"
+                                      "Daniel Sedin,VAN,82,104\n";
+   const std::string duplicated = "Name,Player,GP,PTS,Team\n"
+                                  "Henrik Sedin,Henrik Sedin,82,94,VAN\n";
+   const std::string* data[] = { &with_header, &without_header, &duplicated };
+
+   strtk::token_grid::options options;
+   options.set_column_delimiters(",");
+   options.set_column_split_option(strtk::split_options::default_mode);
+
+   for (std::size_t i = 0; i < sizeof(data) / sizeof(data[0]); ++i)
+   {
+      strtk::token_grid grid(*data[i],data[i]->size(),options);
+      strtk::grid_binding<skater_line> binding;
+      std::string error;
+      if (!binding.resolve(grid,error))
+      {
+         std::cout << "token_grid_test20() - " << error << std::endl;
+         continue;
+      }
+      for (std::size_t r = binding.first_row(); r < grid.row_count(); ++r)
+      {
+         skater_line line;
+         line.pim = 0;
+         if (binding.parse(grid.row(r),line))
+            std::cout << line.name << " (" << line.team << ") " << line.pts << "pts in " << line.gp << "gp" << std::endl;
+      }
+   }
+}
+
+void token_grid_test21()
+{
+   // Quoted fields with delimiters in them, CRLF rows, an unclosed quote (which only runs to the end of
+   // its row) and the empty token a closing quote leaves at the end of a row. Repeated so the quotes
+   // land on different spots of the blocks the indexer works through.
+   const std::string rows = "Name,Team,Note\r\n"
+                            "\"Crosby, Sidney\",PIT,\"C, captain\"\r\n"
+                            "\"Malkin, Evgeni,PIT,C\r\n"
+                            "Kunitz,PIT,LW\r\n"
+                            "Letang,PIT,\"D\"\n";
+   const char* expected[] = {
+                              "[Name] [Team] [Note] ",
+                              "[] [Crosby, Sidney] [PIT] [C, captain] [] ",
+                              "[] [Malkin, Evgeni,PIT,C] ",
+                              "[Kunitz] [PIT] [LW] ",
+                              "[Letang] [PIT] [D] [] "
+                            };
+   const std::size_t expected_count = sizeof(expected) / sizeof(expected[0]);
+   const std::size_t repeats = 4;
+
+   std::string data;
+   for (std::size_t i = 0; i < repeats; ++i)
+   {
+      data += rows;
+   }
+
+   strtk::token_grid::options options;
+   options.set_column_delimiters(",");
+   options.support_dquotes = true;
+
+   strtk::token_grid grid(data,data.size(),options);
+
+   if (grid.row_count() != repeats * expected_count)
+   {
+      std::cout << "token_grid_test21() - expected " << repeats * expected_count << " rows, got " << grid.row_count() << std::endl;
+      return;
+   }
+
+   for (std::size_t r = 0; r < grid.row_count(); ++r)
+   {
+      strtk::token_grid::row_type row = grid.row(r);
+      std::string text;
+      for (std::size_t c = 0; c < row.size(); ++c)
+      {
+         text += "[" + row.get<std::string>(c) + "] ";
+      }
+      if (text != expected[r % expected_count])
+         std::cout << "token_grid_test21() - row " << r << " is " << text << "expected " << expected[r % expected_count] << std::endl;
+      else if (r < expected_count)
+         std::cout << text << std::endl;
+   }
+}
+
 int main()
 {
    token_grid_test01();
@@ -847,5 +1083,11 @@ int main()
    token_grid_test13();
    token_grid_test14();
    token_grid_test15();
+   token_grid_test16();
+   token_grid_test17();
+   token_grid_test18();
+   token_grid_test19();
+   token_grid_test20();
+   token_grid_test21();
    return 0;
 }
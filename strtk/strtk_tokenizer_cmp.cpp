@@ -171,6 +171,86 @@ void boost_split_timed_test()
           s.size() / (1048576.0 * t.time()));
 }
 
+// Rows of a stats file, split on the same delimiters token_grid uses by default
+static const std::string csv_base = "Pavel Datsyuk,C,DET,2,2,4,6,2,0,4,50.0,0,36:08:00,0,3,0,0,0,0\n";
+static const std::size_t csv_replicate_count = 400000;
+static const std::string csv_delimiters = ",|;\t \n\r";
+
+// Same answers as multiple_char_delimiter_predicate, but split can only ask it a char at a time
+struct scalar_delimiter_predicate
+{
+   scalar_delimiter_predicate(const strtk::multiple_char_delimiter_predicate& predicate)
+   : predicate_(predicate)
+   {}
+
+   inline bool operator()(const char c) const
+   {
+      return predicate_(c);
+   }
+
+   const strtk::multiple_char_delimiter_predicate& predicate_;
+};
+
+// Counts tokens rather than keeping them, so it's the splitting that gets timed
+struct token_counter
+{
+   token_counter(std::size_t& count)
+   : count_(&count)
+   {}
+
+   inline token_counter& operator*()  { return (*this); }
+   inline token_counter& operator++() { return (*this); }
+
+   template <typename Iterator>
+   inline token_counter& operator=(const std::pair<Iterator,Iterator>&)
+   {
+      ++(*count_);
+      return (*this);
+   }
+
+   std::size_t* count_;
+};
+
+static const std::size_t split_predicate_rounds = 10;
+
+template <typename DelimiterPredicate>
+void strtk_split_predicate_timed_test(const std::string& mode,
+                                      const std::string& base_string,
+                                      const std::size_t replicate_count,
+                                      const DelimiterPredicate& predicate)
+{
+   print_mode(mode);
+   std::string s;
+   s.reserve(base_string.size() * replicate_count);
+   strtk::replicate(replicate_count,base_string,s);
+   std::size_t token_count = 0;
+   strtk::util::timer t;
+   t.start();
+   for (std::size_t r = 0; r < split_predicate_rounds; ++r)
+   {
+      strtk::split(predicate,
+                   s.data(), s.data() + s.size(),
+                   token_counter(token_count),
+                   strtk::split_options::compress_delimiters);
+   }
+   t.stop();
+   printf("Tokens:%10lu\tTime:%8.4fsec\tRate:%14.4ftks/sec %5.2fMB/s\n",
+          static_cast<unsigned long>(token_count),
+          t.time(),
+          token_count / t.time(),
+          (split_predicate_rounds * s.size()) / (1048576.0 * t.time()));
+}
+
+void strtk_split_simd_timed_test()
+{
+   strtk::multiple_char_delimiter_predicate predicate(delimiters);
+   strtk::multiple_char_delimiter_predicate csv_predicate(csv_delimiters);
+   strtk_split_predicate_timed_test("[scalar]",base,split_replicate_count,scalar_delimiter_predicate(predicate));
+   strtk_split_predicate_timed_test("[strtk]",base,split_replicate_count,predicate);
+   strtk_split_predicate_timed_test("[scalar]",csv_base,csv_replicate_count,scalar_delimiter_predicate(csv_predicate));
+   strtk_split_predicate_timed_test("[strtk]",csv_base,csv_replicate_count,csv_predicate);
+}
+
 static const int max_i2s = 80000000;
 
 void sprintf_lexical_cast_test_i2s()
@@ -813,6 +893,32 @@ void strtk_cast_test_s2d()
           (s2d_rounds * v_size) / t.time());
 }
 
+void strtkfast_cast_test_s2d()
+{
+   print_mode("[fast]");
+   double sum = 0.0;
+   double d   = 0.0;
+   strtk::util::timer t;
+   t.start();
+   for (std::size_t r = 0; r < s2d_rounds; ++r)
+   {
+      for (std::size_t i = 0; i < v_size; ++i)
+      {
+         strtk::fast::real_convert(v[i],d);
+         if (r & 1)
+            sum += d;
+         else
+            sum -= d;
+      }
+   }
+   t.stop();
+   printf("Numbers:%10llu\tError:%14.12f\tTime:%8.4fsec\tRate:%14.4fnums/sec\n",
+          static_cast<unsigned long long>(s2d_rounds * v_size),
+          std::abs(sum),
+          t.time(),
+          (s2d_rounds * v_size) / t.time());
+}
+
 int main()
 {
    std::cout << "Tokenizer Test" << std::endl;
@@ -821,6 +927,8 @@ int main()
    std::cout << "Split Test" << std::endl;
    boost_split_timed_test();
    strtk_split_timed_test();
+   std::cout << "Split Predicate Test (long tokens, then csv)" << std::endl;
+   strtk_split_simd_timed_test();
    std::cout << "Integer To String Test" << std::endl;
    sprintf_lexical_cast_test_i2s();
    boost_lexical_cast_test_i2s();
@@ -837,5 +945,6 @@ int main()
    boost_cast_test_s2d();
    qi_cast_test_s2d();
    strtk_cast_test_s2d();
+   strtkfast_cast_test_s2d();
    return 0;
 }
@@ -1,4 +1,8 @@
+#pragma once
+
+#include <map>
 #include <string>
+#include <vector>
 
 struct Player
 {
@@ -14,4 +18,39 @@ struct Player
   }
 };
 
-typedef std::vector<Player> Players;
\ No newline at end of file
+typedef std::vector<Player> Players;
+
+struct Team
+{
+  std::string name;
+  char conf;
+  int seed;
+  int won;
+  int lost;
+  int otlost;
+  int gf;     // goals for and against over the season, 0 when we don't have them
+  int ga;
+  int record; // unique per set of stats, so scenarios can tell which teams they've changed
+
+  bool operator<(Team const& t) const
+  {
+    if      (conf < t.conf) return true;
+    else if (conf > t.conf) return false;
+    else {
+      return (seed < t.seed);
+    };
+  }
+};
+
+typedef std::vector<Team>         Teams;
+typedef std::map<Team, float>     TeamGamesPlayed;
+typedef std::pair<Team, Team>     Matchup;
+typedef std::vector<Matchup>      Matchups;
+typedef std::pair<int, int>       GameSplit;
+typedef std::pair<Player, float>  PlayerPoints;
+typedef std::vector<PlayerPoints> PlayerPointsList;
+
+// Known series results, keyed by the two team names in matchup order (wins for each side)
+// A side with 4 wins means the series is decided, otherwise it's still in progress
+typedef std::pair<std::string, std::string> SeriesKey;
+typedef std::map<SeriesKey, GameSplit>      BracketState;